@@ -0,0 +1,111 @@
+// This file is part of an MIT-licensed project: see LICENSE file or README.md for details.
+// Copyright (c) 2025 Ian Thomas
+
+namespace Dink.Tests;
+using DinkTool;
+using System.IO;
+using System.Text.Json;
+using DinkCompiler;
+using Ink;
+
+[Collection("Compiler")]
+public class CompilerEventsTest
+{
+    private List<JsonElement> RunWithEvents(Func<bool> run, out bool success)
+    {
+        var writer = new StringWriter();
+        CompilerEvents.Enabled = true;
+        CompilerEvents.Writer = writer;
+        try
+        {
+            success = run();
+        }
+        finally
+        {
+            CompilerEvents.Enabled = false;
+            CompilerEvents.Writer = null;
+        }
+
+        var events = new List<JsonElement>();
+        foreach (var line in writer.ToString().Split('\n', StringSplitOptions.RemoveEmptyEntries))
+            events.Add(JsonDocument.Parse(line).RootElement.Clone());
+        return events;
+    }
+
+    private static IEnumerable<JsonElement> OfType(List<JsonElement> events, string type)
+    {
+        return events.Where(e => e.GetProperty("Event").GetString() == type);
+    }
+
+    [Fact]
+    public void EmitsPhaseOutputAndResult()
+    {
+        var settings = new ProjectSettings()
+        {
+            Source = "../../../../../tests/test1/main.ink",
+            DestFolder = "./output"
+        };
+        var env = new ProjectEnvironment(settings);
+        env.Init();
+
+        var events = RunWithEvents(() => new Compiler(env).Run(), out bool success);
+        Assert.True(success);
+
+        var phases = OfType(events, "Phase").Select(e => e.GetProperty("Name").GetString()).ToList();
+        Assert.Contains("CompileInk", phases);
+        Assert.Contains("WriteDinkMinimal", phases);
+
+        var outputs = OfType(events, "Output").Select(e => e.GetProperty("Path").GetString()!).ToList();
+        Assert.Contains(outputs, p => p.EndsWith("main-dink.json"));
+        Assert.All(outputs, p => Assert.True(Path.IsPathFullyQualified(p)));
+
+        var result = Assert.Single(OfType(events, "Result"));
+        Assert.True(result.GetProperty("Success").GetBoolean());
+        Assert.Equal("Result", events.Last().GetProperty("Event").GetString());
+    }
+
+    [Fact]
+    public void SplitsInkErrorIntoFileAndLine()
+    {
+        string inkFolder = Path.GetFullPath("./ink");
+        var events = RunWithEvents(() =>
+        {
+            CompilerEvents.InkDiagnostic("ERROR: 'scene1.ink' line 12: Divert target not found", ErrorType.Error, inkFolder);
+            return true;
+        }, out _);
+
+        var diagnostic = Assert.Single(OfType(events, "Diagnostic"));
+        Assert.Equal("Error", diagnostic.GetProperty("Severity").GetString());
+        Assert.Equal(Path.Combine(inkFolder, "scene1.ink"), diagnostic.GetProperty("File").GetString());
+        Assert.Equal(12, diagnostic.GetProperty("Line").GetInt32());
+        Assert.Equal("Divert target not found", diagnostic.GetProperty("Message").GetString());
+    }
+
+    [Fact]
+    public void ReportsInkCompileErrorsWithAbsolutePaths()
+    {
+        string folder = Path.GetFullPath("./broken");
+        Directory.CreateDirectory(folder);
+        File.WriteAllText(Path.Combine(folder, "main.ink"), "Hello.\n-> missing_knot\n");
+
+        var settings = new ProjectSettings()
+        {
+            Source = Path.Combine(folder, "main.ink"),
+            DestFolder = Path.Combine(folder, "output")
+        };
+        var env = new ProjectEnvironment(settings);
+        env.Init();
+
+        var events = RunWithEvents(() => new Compiler(env).Run(), out bool success);
+        Assert.False(success);
+
+        var errors = OfType(events, "Diagnostic")
+            .Where(e => e.GetProperty("Severity").GetString() == "Error").ToList();
+        Assert.NotEmpty(errors);
+        Assert.Contains(errors, e => e.GetProperty("File").GetString() == Path.Combine(folder, "main.ink")
+            && e.GetProperty("Line").GetInt32() == 2);
+
+        var result = Assert.Single(OfType(events, "Result"));
+        Assert.False(result.GetProperty("Success").GetBoolean());
+    }
+}
@@ -6,6 +6,8 @@ using DinkTool;
 using System.IO;
 using DinkCompiler;
 
+// Compiler runs change the working directory, so they mustn't run in parallel.
+[Collection("Compiler")]
 public class ParserTest
 {
     private string loadTestFile(string fileName) {
@@ -48,6 +48,7 @@ public static class DinkJson
                         exportData[beat.LineID] = new
                         {
                             Type = "Action",
+                            SceneID = scene.SceneID,
                             Text = action.Text
                         };
                     }
@@ -57,6 +58,7 @@ public static class DinkJson
                     exportData[beat.LineID] = new
                     {
                         Type = "Line",
+                        SceneID = scene.SceneID,
                         CharacterID = line.CharacterID,
                         Qualifier = line.Qualifier
                     };
@@ -51,6 +51,14 @@ public class DinkParser
             Console.WriteLine(str);
     }
 
+    // Optional hook so tools can receive parse problems with their origin,
+    // as well as the console output. Arguments are severity, message, origin.
+    public static Action<string, string, DinkOrigin>? DiagnosticHandler;
+    private static void Diagnostic(string severity, string message, DinkOrigin origin)
+    {
+        DiagnosticHandler?.Invoke(severity, message, origin);
+    }
+
     private static int GetBraceDelta(string line)
     {
         int delta = 0;
@@ -505,6 +513,7 @@ public class DinkParser
             if (IDs.Contains(id))
             {
                 Console.Error.WriteLine($"Duplicate ID {id} at {origin}");
+                Diagnostic("Error", $"Duplicate ID {id}", origin);
                 return false;
             }
             IDs.Add(id);
@@ -770,6 +779,7 @@ public class DinkParser
                             if (string.IsNullOrEmpty(dinkLine.LineID))
                             {
                                 Console.Error.WriteLine($"Couldn't find an ID at option line {line.Origin}");
+                                Diagnostic("Error", "Couldn't find an ID at option line", line.Origin);
                                 return false;
                             }
 
@@ -815,6 +825,7 @@ public class DinkParser
                     {
                         Console.Error.WriteLine("Dink Format Error: Line starts with expression but has content after colon.");
                         Console.Error.WriteLine($"    {trimmedLine}");
+                        Diagnostic("Error", "Line starts with expression but has content after colon.", line.Origin);
                     }
                 }
                 else
@@ -866,6 +877,7 @@ public class DinkParser
                 {
                     Console.WriteLine("A Dink line is present in a block without a #dink tag. This doesn't look right!");
                     Console.WriteLine($"    {trimmedLine}");
+                    Diagnostic("Warning", "A Dink line is present in a block without a #dink tag.", line.Origin);
                 }
                 else
                 {
@@ -3,6 +3,7 @@
 
 namespace DinkCompiler;
 
+using System.Diagnostics;
 using System.Text;
 using Dink;
 using Ink;
@@ -22,9 +23,21 @@ public class Compiler
     }
     public bool Run()
     {
+        var stopwatch = Stopwatch.StartNew();
+        CompilerEvents.BaseFolder = _env.ProjectFolder;
+        bool success = RunSteps();
+        CompilerEvents.Result(success, stopwatch.Elapsed.TotalSeconds);
+        return success;
+    }
+
+    private bool RunSteps()
+    {
+        using var phase = new PhaseTimer();
+
         // Steps:
 
         // ----- Process Ink files for string data and IDs -----
+        phase.Begin("InkStrings");
         bool success = ProcessInkStrings(_env.SourceInkFile, out LocStrings inkStrings, 
             out List<string> usedInkFiles, out Dictionary<string, Localiser.Origin> origins);
         UsedInkFiles = usedInkFiles;
@@ -32,10 +45,12 @@ public class Compiler
             return false;
 
         // ----- Compile to json -----
+        phase.Begin("CompileInk");
         if (!CompileToJson(_env.SourceInkFile, inkStrings, !_env.NoStrip, _env.DestCompiledInkFile))
             return false;
 
         // ----- Read characters -----
+        phase.Begin("ReadCharacters");
         string? charFile = _env.FindFileInSource("characters.json");
         // Character list is optional.
         ReadCharacters(charFile, out Characters? characters);
@@ -49,24 +64,29 @@ public class Compiler
         }
 
         // ----- Parse ink files, extract Dink beats -----
+        phase.Begin("ParseDink");
         if (!ParseDinkScenes(usedInkFiles, characters, previousScenes,
             out List<DinkScene> dinkScenes, out List<NonDinkLine> nonDinkLines))
             return false;
 
         // ---- Remove any action and character references from the localisation -----
+        phase.Begin("FixLoc");
         if (!FixLoc(dinkScenes, nonDinkLines, inkStrings))
             return false;
 
         // ---- Build writing statuses for lines. This might affect localisation and recording -----
+        phase.Begin("WritingStatuses");
         var writingStatuses = new WritingStatuses(_env);
         if (!writingStatuses.Build(dinkScenes, nonDinkLines, inkStrings))
             return false;
 
         // ----- Build voice lines -----
+        phase.Begin("VoiceLines");
         if (!BuildVoiceLines(dinkScenes, out VoiceLines voiceLines))
             return false;
 
         // ----- Create TTS audio if desired -----
+        phase.Begin("TTS");
         if (_env.GoogleTTS.Generate)
         {
             if (characters==null)
@@ -80,11 +100,13 @@ public class Compiler
         }
 
         // ----- Gather voice line statuses -----
+        phase.Begin("AudioStatuses");
         var audioStatuses = new AudioStatuses(_env);
         if (!audioStatuses.Build(voiceLines))
             return false;
 
         // ----- Output Voice Lines -----
+        phase.Begin("WriteRecordingScript");
         if (_env.OutputRecordingScript)
         {
             if (!WriteRecordingScript(voiceLines, writingStatuses, audioStatuses, characters, _env.DestRecordingScriptFile))
@@ -92,6 +114,7 @@ public class Compiler
         }
 
         // ----- Output Dink Structure -----
+        phase.Begin("WriteDinkStructure");
         if (_env.OutputDinkStructure)
         {
             if (!WriteStructuredDink(dinkScenes, _env.DestDinkStructureFile))
@@ -99,14 +122,17 @@ public class Compiler
         }
 
         // ----- Output Dink Minimal for runtime -----
+        phase.Begin("WriteDinkMinimal");
         if (!WriteMinimalDink(dinkScenes, _env.DestDinkFile))
             return false;
 
         // ----- Output lines minimal for runtime -----
+        phase.Begin("WriteStrings");
         if (!WriteMinimalStrings(inkStrings, _env.DestRuntimeStringsFile))
             return false;
 
         // ----- Output lines for localisation (Excel) -----
+        phase.Begin("WriteLocalization");
         if (_env.OutputLocalization)
         {
             if (!WriteLocalizationFile(inkStrings, writingStatuses, _env.DestLocFile))
@@ -114,6 +140,7 @@ public class Compiler
         }
 
         // ----- Output general stats (Excel) -----
+        phase.Begin("WriteStats");
         if (_env.OutputStats)
         {
             if (!Stats.WriteExcelFile(_env.RootFilename, dinkScenes, nonDinkLines, 
@@ -121,15 +148,18 @@ public class Compiler
                         characters,
                         _env.DestStatsFile))
                 return false;
+            CompilerEvents.OutputFile(_env.DestStatsFile);
         }
 
         // ----- Output origins (JSON) -----
+        phase.Begin("WriteOrigins");
         if (_env.OutputOrigins)
         {
             if (!WriteOrigins(origins, _env.DestOriginsFile))
                 return false;
         }
 
+        phase.End();
         Console.WriteLine("Processing complete.");
         return true;
     }
@@ -186,9 +216,12 @@ public class Compiler
     }
 
     List<string> _compileErrors = new List<string>();
+    string _inkFolder = "";
 
     private void OnCompileError(string message, ErrorType errorType)
     {
+        CompilerEvents.InkDiagnostic(message, errorType, _inkFolder);
+
         switch (errorType)
         {
             case ErrorType.Author:
@@ -213,7 +246,8 @@ public class Compiler
         Console.WriteLine("Compiling Ink to JSON... " + sourceInkFile);
 
         string cwd = Directory.GetCurrentDirectory();
-        Directory.SetCurrentDirectory(Path.GetDirectoryName(sourceInkFile) ?? Directory.GetCurrentDirectory());
+        _inkFolder = Path.GetDirectoryName(sourceInkFile) ?? Directory.GetCurrentDirectory();
+        Directory.SetCurrentDirectory(_inkFolder);
 
         var fileHandler = new InkFileHandler(inkStrings, stripText);
         string inputString = fileHandler.LoadInkFileContents(sourceInkFile);
@@ -243,8 +277,11 @@ public class Compiler
             catch
             {
                 Console.WriteLine("Could not write to output file '" + destFile + "'");
+                CompilerEvents.Diagnostic("Error", "Could not write to output file", destFile);
                 success = false;
             }
+            if (success)
+                CompilerEvents.OutputFile(destFile);
         }
         Directory.SetCurrentDirectory(cwd);
         return success;
@@ -268,6 +305,7 @@ public class Compiler
                     scenes, ndLines, previousParsedScenes))
             {
                 Console.Error.WriteLine("Failed to parse Dink in file: " + inkFile);
+                CompilerEvents.Diagnostic("Error", "Failed to parse Dink", inkFileRelativeToProject);
                 return false;
             }
 
@@ -280,6 +318,7 @@ public class Compiler
                         if (!characters.Has(line.CharacterID))
                         {
                             Console.Error.WriteLine($"Error in file {line.Origin.ToString()}, line {line.LineID} - character '{line.CharacterID}' not in the characters file.:");
+                            CompilerEvents.Diagnostic("Error", $"Line {line.LineID} - character '{line.CharacterID}' not in the characters file.", line.Origin);
                             return false;
                         }
                     }
@@ -415,10 +454,12 @@ public class Compiler
         {
             string fileContents = DinkJson.WriteScenes(dinkScenes);
             File.WriteAllText(destDinkFile, fileContents, Encoding.UTF8);
+            CompilerEvents.OutputFile(destDinkFile);
         }
         catch (Exception ex)
         {
             Console.Error.WriteLine($"Error writing out Dink JSON file {destDinkFile}: " + ex.Message);
+            CompilerEvents.Diagnostic("Error", "Error writing out Dink JSON file: " + ex.Message, destDinkFile);
             return false;
         }
         return true;
@@ -432,10 +473,12 @@ public class Compiler
         {
             string fileContents = DinkJson.WriteMinimal(dinkScenes, !_env.LocActions);
             File.WriteAllText(destDinkFile, fileContents, Encoding.UTF8);
+            CompilerEvents.OutputFile(destDinkFile);
         }
         catch (Exception ex)
         {
             Console.Error.WriteLine($"Error writing out Dink JSON file {destDinkFile}: " + ex.Message);
+            CompilerEvents.Diagnostic("Error", "Error writing out Dink JSON file: " + ex.Message, destDinkFile);
             return false;
         }
         return true;
@@ -449,10 +492,12 @@ public class Compiler
         {
             string fileContents = inkStrings.WriteMinimal();
             File.WriteAllText(destStringsFile, fileContents, Encoding.UTF8);
+            CompilerEvents.OutputFile(destStringsFile);
         }
         catch (Exception ex)
         {
             Console.Error.WriteLine($"Error writing out JSON file {destStringsFile}: " + ex.Message);
+            CompilerEvents.Diagnostic("Error", "Error writing out JSON file: " + ex.Message, destStringsFile);
             return false;
         }
         return true;
@@ -463,6 +508,7 @@ public class Compiler
         Console.WriteLine("Writing recording script file: " + destRecordingFile);
         if (!voiceLines.WriteToExcel(_env.RootFilename, characters, writingStatuses, _env.IgnoreWritingStatus, audioStatuses, destRecordingFile))
             return false;
+        CompilerEvents.OutputFile(destRecordingFile);
         return true;
     }
 
@@ -470,6 +516,7 @@ public class Compiler
     {
         if (!inkStrings.WriteToExcel(_env.RootFilename, writingStatuses, _env.IgnoreWritingStatus, destLocFile))
             return false;
+        CompilerEvents.OutputFile(destLocFile);
         return true;
     }
 
@@ -482,9 +529,12 @@ public class Compiler
             string fileContents = JsonSerializer.Serialize(origins, options);
 
             File.WriteAllText(destOriginsFile, fileContents, Encoding.UTF8);
+
+            CompilerEvents.OutputFile(destOriginsFile);
         }
         catch (Exception ex) {
                 Console.Error.WriteLine($"Error writing out origins JSON file {destOriginsFile}: " + ex.Message);
+                CompilerEvents.Diagnostic("Error", "Error writing out origins JSON file: " + ex.Message, destOriginsFile);
             return false;
         }
         return true;
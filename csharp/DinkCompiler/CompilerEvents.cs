@@ -0,0 +1,146 @@
+// This file is part of an MIT-licensed project: see LICENSE file or README.md for details.
+// Copyright (c) 2025 Ian Thomas
+
+namespace DinkCompiler;
+
+using System.Diagnostics;
+using System.Text.Json;
+using System.Text.RegularExpressions;
+using Dink;
+using Ink;
+
+// Machine-readable output for tools driving the compiler (e.g. the Unreal plugin).
+// When enabled, each event is written to stdout as a single-line JSON object
+// with an "Event" field, interleaved with the normal human-readable log.
+// All paths in events are absolute, so tools can open them directly.
+public static class CompilerEvents
+{
+    public static bool Enabled = false;
+
+    // Where events are written. Defaults to stdout.
+    public static TextWriter? Writer = null;
+
+    // Relative paths (e.g. Dink origins) are resolved against this folder.
+    public static string BaseFolder = "";
+
+    private static readonly object _lock = new object();
+
+    // Ink reports errors as e.g. "ERROR: 'main.ink' line 12: Some message"
+    private static readonly Regex _inkErrorRegex = new Regex(@"'(?<file>[^']+)' line (?<line>\d+): (?<message>.*)$");
+
+    public static void Diagnostic(string severity, string message, string file = "", int line = 0)
+    {
+        Write(new
+        {
+            Event = "Diagnostic",
+            Severity = severity,
+            File = ResolvePath(file, BaseFolder),
+            Line = line,
+            Message = message
+        });
+    }
+
+    public static void Diagnostic(string severity, string message, DinkOrigin origin)
+    {
+        Diagnostic(severity, message, origin.SourceFilePath ?? "", origin.LineNum);
+    }
+
+    // Ink names files as they were included, relative to the root Ink file's folder.
+    public static void InkDiagnostic(string message, ErrorType errorType, string inkFolder)
+    {
+        string severity = errorType switch
+        {
+            ErrorType.Error => "Error",
+            ErrorType.Warning => "Warning",
+            _ => "Info"
+        };
+
+        Match match = _inkErrorRegex.Match(message);
+        if (match.Success)
+            Diagnostic(severity, match.Groups["message"].Value,
+                ResolvePath(match.Groups["file"].Value, inkFolder), int.Parse(match.Groups["line"].Value));
+        else
+            Diagnostic(severity, message);
+    }
+
+    public static void OutputFile(string path)
+    {
+        Write(new
+        {
+            Event = "Output",
+            Path = ResolvePath(path, BaseFolder)
+        });
+    }
+
+    public static void PhaseComplete(string name, double seconds)
+    {
+        Write(new
+        {
+            Event = "Phase",
+            Name = name,
+            Seconds = seconds
+        });
+    }
+
+    public static void Result(bool success, double seconds)
+    {
+        Write(new
+        {
+            Event = "Result",
+            Success = success,
+            Seconds = seconds
+        });
+    }
+
+    private static string ResolvePath(string path, string baseFolder)
+    {
+        if (string.IsNullOrEmpty(path))
+            return "";
+        if (string.IsNullOrEmpty(baseFolder))
+            return Path.GetFullPath(path);
+        return Path.GetFullPath(path, Path.GetFullPath(baseFolder));
+    }
+
+    private static void Write(object evt)
+    {
+        if (!Enabled)
+            return;
+
+        string json = JsonSerializer.Serialize(evt);
+        lock (_lock)
+        {
+            TextWriter writer = Writer ?? Console.Out;
+            writer.WriteLine(json);
+            writer.Flush();
+        }
+    }
+}
+
+// Times consecutive compiler phases. Starting a phase ends the previous one,
+// and disposing ends the last, so early returns still report their timing.
+public sealed class PhaseTimer : IDisposable
+{
+    private readonly Stopwatch _stopwatch = new Stopwatch();
+    private string? _current;
+
+    public void Begin(string name)
+    {
+        End();
+        _current = name;
+        _stopwatch.Restart();
+    }
+
+    public void End()
+    {
+        if (_current == null)
+            return;
+        _stopwatch.Stop();
+        CompilerEvents.PhaseComplete(_current, _stopwatch.Elapsed.TotalSeconds);
+        _current = null;
+    }
+
+    public void Dispose()
+    {
+        End();
+    }
+}
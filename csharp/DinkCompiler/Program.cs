@@ -1,4 +1,5 @@
 using DinkCompiler;
+using Dink;
 using DinkTool;
 using System.CommandLine;
 
@@ -82,6 +83,12 @@ Option<bool> nostripOption = new("--nostrip")
 };
 command.Options.Add(nostripOption);
 
+Option<bool> eventsOption = new("--events")
+{
+    Description = "Also write machine-readable JSON lines to stdout: diagnostics, phase timings and output files."
+};
+command.Options.Add(eventsOption);
+
 command.Validators.Add(result =>
 {
     // Is a project file specified?
@@ -126,6 +133,12 @@ command.SetAction(parseResult =>
     if (parseResult.GetValue<bool>(nostripOption))
         settings.NoStrip = true;
 
+    if (parseResult.GetValue<bool>(eventsOption))
+    {
+        CompilerEvents.Enabled = true;
+        DinkParser.DiagnosticHandler = CompilerEvents.Diagnostic;
+    }
+
     ProjectEnvironment env = new ProjectEnvironment(settings);
     if (!env.Init())
         return -1;
@@ -25,7 +25,8 @@ public class Dink : ModuleRules
 			{
 				"Core",
                 "CoreUObject",
-                "Engine"
+                "Engine",
+                "DeveloperSettings"
             }
             );
 			
@@ -1,4 +1,11 @@
 #include "Dink.h"
+#include "DinkRuntime.h"
+#include "DinkRuntimeParser.h"
+#include "DinkSettings.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+#include "Misc/ScopeLock.h"
+#include "Async/Async.h"
 
 #define LOCTEXT_NAMESPACE "FDinkModule"
 
@@ -30,10 +37,428 @@ UDink::UDink()
 void UDink::Initialize(FSubsystemCollectionBase& InCollection)
 {
 	Super::Initialize(InCollection);
+
+	ReclaimTicker = FTSTicker::GetCoreTicker().AddTicker(TEXT("DinkReclaimSnapshots"), 0.0f, [this](float) {
+		Snapshots.Reclaim();
+		return true;
+	});
+}
+
+void UDink::Deinitialize()
+{
+	FTSTicker::GetCoreTicker().RemoveTicker(ReclaimTicker);
+
+	Super::Deinitialize();
 }
 
 void UDink::Register()
 {
+    const UDinkSettings* Settings = GetDefault<UDinkSettings>();
+    if (Settings && !Settings->ChunkManifestPath.IsEmpty())
+    {
+        LoadChunkManifest(FPaths::Combine(FPaths::ProjectContentDir(), Settings->ChunkManifestPath));
+    }
+}
+
+bool UDink::LoadRuntime(const FString& JsonRaw)
+{
+    TSharedPtr<FDinkBeatData> Data = MakeShared<FDinkBeatData>();
+    if (!UDinkRuntimeParser::ParseJSON(JsonRaw, Data->Beats, Data->ActionText))
+        return false;
+
+    Data->LineIndex.Build(Data->Beats);
+
+    TArray<TFunction<void(bool)>> Failed;
+    {
+        FScopeLock Lock(&WriteLock);
+
+        // The whole file replaces any chunked data, or lookups would see both
+        RuntimeBeats = Data;
+        Manifest.Reset();
+        Failed = ResetChunks();
+        PublishSnapshot();
+    }
+
+    for (TFunction<void(bool)>& OnLoaded : Failed)
+        OnLoaded(false);
+
+    UE_LOG(LogDink, Log, TEXT("Loaded %d Dink beats."), Data->Beats.Num());
+    return true;
+}
+
+bool UDink::LoadStrings(const FString& JsonRaw)
+{
+    TSharedPtr<TMap<FName, FString>> Strings = MakeShared<TMap<FName, FString>>();
+    if (!UDinkRuntimeParser::ParseStringsJSON(JsonRaw, *Strings))
+        return false;
+
+    FScopeLock Lock(&WriteLock);
+
+    RuntimeStrings = Strings;
+    PublishSnapshot();
+
+    UE_LOG(LogDink, Log, TEXT("Loaded %d Dink strings."), Strings->Num());
+    return true;
+}
+
+bool UDink::LoadChunkManifest(const FString& ManifestFile, const FString& Locale)
+{
+    FString JsonRaw;
+    if (!FFileHelper::LoadFileToString(JsonRaw, *ManifestFile))
+    {
+        UE_LOG(LogDink, Error, TEXT("Couldn't read Dink chunk manifest: %s"), *ManifestFile);
+        return false;
+    }
+
+    TSharedPtr<FDinkChunkManifest> NewManifest = MakeShared<FDinkChunkManifest>();
+    if (!UDinkRuntimeParser::ParseManifestJSON(JsonRaw, Locale, *NewManifest))
+        return false;
+    NewManifest->BaseDir = FPaths::GetPath(ManifestFile);
+
+    TSharedPtr<TMap<FName, FString>> Strings = MakeShared<TMap<FName, FString>>();
+    if (!NewManifest->CommonStringsFile.IsEmpty())
+    {
+        FString StringsRaw;
+        FString StringsFile = FPaths::Combine(NewManifest->BaseDir, NewManifest->CommonStringsFile);
+        if (!FFileHelper::LoadFileToString(StringsRaw, *StringsFile) || !UDinkRuntimeParser::ParseStringsJSON(StringsRaw, *Strings))
+        {
+            UE_LOG(LogDink, Error, TEXT("Couldn't load Dink strings: %s"), *StringsFile);
+            return false;
+        }
+    }
+
+    TArray<TFunction<void(bool)>> Failed;
+    {
+        FScopeLock Lock(&WriteLock);
+
+        RuntimeBeats.Reset();
+        RuntimeStrings = Strings;
+        Manifest = NewManifest;
+        Failed = ResetChunks();
+        PublishSnapshot();
+    }
+
+    for (TFunction<void(bool)>& OnLoaded : Failed)
+        OnLoaded(false);
+
+    UE_LOG(LogDink, Log, TEXT("Loaded Dink chunk manifest with %d scenes, locale %s."), NewManifest->DinkFiles.Num(), *NewManifest->Locale);
+    return true;
+}
+
+EDinkSceneRequest UDink::RequestScene(FName SceneID, const FOnDinkSceneLoaded& OnLoaded)
+{
+    EDinkSceneRequest Result = StreamChunk(SceneID, true, [SceneID, OnLoaded](bool bSuccess) {
+        OnLoaded.ExecuteIfBound(SceneID, bSuccess);
+    });
+
+    if (Result != EDinkSceneRequest::Pending)
+        OnLoaded.ExecuteIfBound(SceneID, Result == EDinkSceneRequest::Resident);
+    return Result;
+}
+
+void UDink::ReleaseScene(FName SceneID)
+{
+    FScopeLock Lock(&WriteLock);
+
+    // Released before it finished streaming in
+    FDinkPendingChunk* Pending = PendingChunks.Find(SceneID);
+    if (Pending && Pending->RefCount > 0)
+    {
+        Pending->RefCount--;
+        return;
+    }
+
+    FDinkResidentChunk* Chunk = Chunks.Find(SceneID);
+
+    // Whole-file scenes aren't refcounted, they're always resident
+    if (!Chunk && !Manifest.IsValid() && RuntimeBeats.IsValid() && RuntimeBeats->LineIndex.HasScene(SceneID))
+        return;
+
+    if (!Chunk || Chunk->RefCount <= 0)
+    {
+        UE_LOG(LogDink, Warning, TEXT("ReleaseScene called for scene %s that wasn't requested."), *SceneID.ToString());
+        return;
+    }
+
+    Chunk->RefCount--;
+    Chunk->LastUsed = ++ChunkUseCounter;
+
+    // Refcounts aren't in the snapshot, so readers only need a new one if a chunk went
+    if (EvictChunks())
+        PublishSnapshot();
+}
+
+bool UDink::IsSceneResident(FName SceneID) const
+{
+    bool bResident = false;
+    ReadSnapshot([&](const FDinkRuntimeSnapshot& Snapshot) {
+        bResident = Snapshot.Chunks.Contains(SceneID);
+    });
+    return bResident;
+}
+
+EDinkSceneRequest UDink::StreamChunk(FName SceneID, bool bAddRef, TFunction<void(bool)> OnLoaded)
+{
+    FScopeLock Lock(&WriteLock);
+
+    if (FDinkResidentChunk* Chunk = Chunks.Find(SceneID))
+    {
+        if (bAddRef)
+            Chunk->RefCount++;
+        Chunk->LastUsed = ++ChunkUseCounter;
+        return EDinkSceneRequest::Resident;
+    }
+
+    if (!Manifest.IsValid())
+    {
+        // Everything loaded with LoadRuntime is resident, so game code can
+        // request scenes the same way whichever path loaded them
+        if (RuntimeBeats.IsValid() && RuntimeBeats->LineIndex.HasScene(SceneID))
+            return EDinkSceneRequest::Resident;
+        return EDinkSceneRequest::Failed;
+    }
+
+    if (!Manifest->DinkFiles.Contains(SceneID))
+    {
+        UE_LOG(LogDink, Warning, TEXT("No Dink chunk for scene %s."), *SceneID.ToString());
+        return EDinkSceneRequest::Failed;
+    }
+
+    // Only the first request for a scene starts a load, later ones wait on it
+    const bool bStart = !PendingChunks.Contains(SceneID);
+    FDinkPendingChunk& Pending = PendingChunks.FindOrAdd(SceneID);
+    if (bAddRef)
+        Pending.RefCount++;
+    if (OnLoaded)
+        Pending.OnLoaded.Add(MoveTemp(OnLoaded));
+
+    if (bStart)
+    {
+        TWeakObjectPtr<UDink> WeakThis(this);
+        TSharedPtr<const FDinkChunkManifest> FromManifest = Manifest;
+        AsyncTask(ENamedThreads::AnyBackgroundThreadNormalTask, [WeakThis, SceneID, FromManifest]() {
+            TSharedPtr<FDinkRuntimeData> Data = ReadChunk(*FromManifest, SceneID);
+            AsyncTask(ENamedThreads::GameThread, [WeakThis, SceneID, FromManifest, Data]() {
+                if (UDink* Dink = WeakThis.Get())
+                    Dink->FinishChunk(SceneID, FromManifest, Data);
+            });
+        });
+    }
+
+    return EDinkSceneRequest::Pending;
+}
+
+TSharedPtr<FDinkRuntimeData> UDink::ReadChunk(const FDinkChunkManifest& FromManifest, FName SceneID)
+{
+    TSharedPtr<FDinkRuntimeData> Data = MakeShared<FDinkRuntimeData>();
+
+    FString JsonRaw;
+    FString DinkPath = FPaths::Combine(FromManifest.BaseDir, FromManifest.DinkFiles[SceneID]);
+    if (!FFileHelper::LoadFileToString(JsonRaw, *DinkPath) || !UDinkRuntimeParser::ParseJSON(JsonRaw, Data->Beats, Data->ActionText))
+    {
+        UE_LOG(LogDink, Error, TEXT("Couldn't load Dink chunk: %s"), *DinkPath);
+        return nullptr;
+    }
+
+    if (const FString* StringsFile = FromManifest.StringsFiles.Find(SceneID))
+    {
+        FString StringsPath = FPaths::Combine(FromManifest.BaseDir, *StringsFile);
+        if (!FFileHelper::LoadFileToString(JsonRaw, *StringsPath) || !UDinkRuntimeParser::ParseStringsJSON(JsonRaw, Data->Strings))
+        {
+            UE_LOG(LogDink, Error, TEXT("Couldn't load Dink strings chunk: %s"), *StringsPath);
+            return nullptr;
+        }
+    }
+
+    if (!FromManifest.bHasLineIndex)
+        Data->LineIndex.Build(Data->Beats);
+
+    return Data;
+}
+
+void UDink::FinishChunk(FName SceneID, const TSharedPtr<const FDinkChunkManifest>& FromManifest, const TSharedPtr<FDinkRuntimeData>& Data)
+{
+    FDinkPendingChunk Pending;
+    {
+        FScopeLock Lock(&WriteLock);
+
+        // If the manifest has been replaced since, its callers have already been failed
+        if (FromManifest != Manifest || !PendingChunks.RemoveAndCopyValue(SceneID, Pending))
+            return;
+
+        if (Data.IsValid())
+        {
+            FDinkResidentChunk& Chunk = Chunks.Add(SceneID);
+            Chunk.Data = Data;
+            Chunk.AllocatedSize = Data->GetAllocatedSize();
+            Chunk.RefCount = Pending.RefCount;
+            Chunk.LastUsed = ++ChunkUseCounter;
+
+            UE_LOG(LogDink, Verbose, TEXT("Streamed in Dink scene %s (%d beats, %llu bytes)."), *SceneID.ToString(), Data->Beats.Num(), (uint64)Chunk.AllocatedSize);
+
+            EvictChunks();
+            PublishSnapshot();
+        }
+    }
+
+    for (TFunction<void(bool)>& OnLoaded : Pending.OnLoaded)
+        OnLoaded(Data.IsValid());
+}
+
+TArray<TFunction<void(bool)>> UDink::ResetChunks()
+{
+    TArray<TFunction<void(bool)>> Failed;
+    for (auto& Pair : PendingChunks)
+        Failed.Append(MoveTemp(Pair.Value.OnLoaded));
+
+    PendingChunks.Reset();
+    Chunks.Reset();
+    return Failed;
+}
+
+bool UDink::EvictChunks()
+{
+    const SIZE_T Budget = (SIZE_T)FMath::Max(GetDefault<UDinkSettings>()->ChunkBudgetKB, 0) * 1024;
+
+    // Requested chunks never go, so only unreferenced ones count against the budget
+    SIZE_T CachedBytes = 0;
+    for (const auto& Pair : Chunks)
+    {
+        if (Pair.Value.RefCount == 0)
+            CachedBytes += Pair.Value.AllocatedSize;
+    }
+
+    bool bEvicted = false;
+    while (CachedBytes > Budget)
+    {
+        FName Oldest = NAME_None;
+        uint64 OldestUse = MAX_uint64;
+        for (const auto& Pair : Chunks)
+        {
+            if (Pair.Value.RefCount == 0 && Pair.Value.LastUsed < OldestUse)
+            {
+                Oldest = Pair.Key;
+                OldestUse = Pair.Value.LastUsed;
+            }
+        }
+
+        // Readers still holding the previous snapshot keep the data alive
+        // through its shared pointer until they're done
+        CachedBytes -= Chunks[Oldest].AllocatedSize;
+        Chunks.Remove(Oldest);
+        bEvicted = true;
+
+        UE_LOG(LogDink, Verbose, TEXT("Evicted Dink scene %s."), *Oldest.ToString());
+    }
+    return bEvicted;
+}
+
+void UDink::PublishSnapshot()
+{
+    TUniquePtr<FDinkRuntimeSnapshot> Snapshot = MakeUnique<FDinkRuntimeSnapshot>();
+    Snapshot->RuntimeBeats = RuntimeBeats;
+    Snapshot->RuntimeStrings = RuntimeStrings;
+    Snapshot->Manifest = Manifest;
+    Snapshot->Chunks.Reserve(Chunks.Num());
+    for (const auto& Pair : Chunks)
+        Snapshot->Chunks.Add(Pair.Key, Pair.Value.Data);
+
+    Snapshots.Publish(MoveTemp(Snapshot));
+}
+
+void UDink::ReadSnapshot(TFunctionRef<void(const FDinkRuntimeSnapshot&)> Func) const
+{
+    Snapshots.Read(Func);
+}
+
+bool UDink::FindBeat(FName LineID, FDinkBeat& OutBeat) const
+{
+    bool bFound = false;
+    ReadSnapshot([&](const FDinkRuntimeSnapshot& Snapshot) {
+        if (const FDinkBeat* Beat = Snapshot.FindBeat(LineID))
+        {
+            OutBeat = *Beat;
+            bFound = true;
+        }
+    });
+    return bFound;
+}
+
+bool UDink::FindString(FName LineID, FString& OutText) const
+{
+    bool bFound = false;
+    ReadSnapshot([&](const FDinkRuntimeSnapshot& Snapshot) {
+        if (const FString* Text = Snapshot.FindString(LineID))
+        {
+            OutText = *Text;
+            bFound = true;
+        }
+    });
+    return bFound;
+}
+
+TArray<FName> UDink::GetLinesForCharacter(FName CharacterID) const
+{
+    TArray<FName> LineIDs;
+    ReadSnapshot([&](const FDinkRuntimeSnapshot& Snapshot) {
+        Snapshot.ForEachLineIndex([&](const FDinkLineIndex& LineIndex) {
+            LineIndex.GetLinesForCharacter(CharacterID, LineIDs);
+        });
+    });
+    return LineIDs;
+}
+
+TArray<FName> UDink::GetLinesForScene(FName SceneID) const
+{
+    TArray<FName> LineIDs;
+    ReadSnapshot([&](const FDinkRuntimeSnapshot& Snapshot) {
+        Snapshot.ForEachLineIndex([&](const FDinkLineIndex& LineIndex) {
+            LineIndex.GetLinesForScene(SceneID, LineIDs);
+        });
+    });
+    return LineIDs;
+}
+
+TArray<FName> UDink::GetLinesForCharacterInScene(FName CharacterID, FName SceneID) const
+{
+    TArray<FName> LineIDs;
+    ReadSnapshot([&](const FDinkRuntimeSnapshot& Snapshot) {
+        Snapshot.ForEachLineIndex([&](const FDinkLineIndex& LineIndex) {
+            LineIndex.GetLinesForCharacterInScene(CharacterID, SceneID, LineIDs);
+        });
+    });
+    return LineIDs;
+}
+
+void UDink::PrefetchScene(FName SceneID, FName CharacterID)
+{
+    // A precomputed index knows every scene's lines, streamed in or not
+    bool bIndexed = false;
+    ReadSnapshot([&](const FDinkRuntimeSnapshot& Snapshot) {
+        bIndexed = Snapshot.Manifest.IsValid() && Snapshot.Manifest->bHasLineIndex;
+    });
+
+    TFunction<void(bool)> OnLoaded;
+    if (!bIndexed)
+    {
+        TWeakObjectPtr<UDink> WeakThis(this);
+        OnLoaded = [WeakThis, SceneID, CharacterID](bool bSuccess) {
+            UDink* Dink = WeakThis.Get();
+            if (Dink && bSuccess)
+                Dink->BroadcastPrefetch(SceneID, CharacterID);
+        };
+    }
+
+    // Prefetching doesn't hold the scene, so its chunk stays evictable
+    if (StreamChunk(SceneID, false, MoveTemp(OnLoaded)) != EDinkSceneRequest::Pending || bIndexed)
+        BroadcastPrefetch(SceneID, CharacterID);
+}
+
+void UDink::BroadcastPrefetch(FName SceneID, FName CharacterID) const
+{
+    TArray<FName> LineIDs = CharacterID.IsNone() ? GetLinesForScene(SceneID) : GetLinesForCharacterInScene(CharacterID, SceneID);
+    if (LineIDs.Num() > 0)
+        OnPrefetchLines.Broadcast(SceneID, LineIDs);
 }
 
 void FDinkModule::StartupModule()
@@ -0,0 +1,177 @@
+#include "DinkLineIndex.h"
+#include "DinkRuntime.h"
+#include "Dom/JsonObject.h"
+
+static void WriteJsonLists(const TMap<FName, TArray<int32>>& Lists, FJsonObject& JsonLists)
+{
+    for (const auto& Pair : Lists)
+    {
+        TArray<TSharedPtr<FJsonValue>> Values;
+        Values.Reserve(Pair.Value.Num());
+        for (int32 Line : Pair.Value)
+            Values.Add(MakeShared<FJsonValueNumber>(Line));
+        JsonLists.SetArrayField(Pair.Key.ToString(), Values);
+    }
+}
+
+static bool ReadJsonLists(const FJsonObject& JsonLists, int32 NumLines, TMap<FName, TArray<int32>>& OutLists)
+{
+    OutLists.Reserve(JsonLists.Values.Num());
+    for (const auto& Pair : JsonLists.Values)
+    {
+        TArray<int32>& Lines = OutLists.Add(FName(*Pair.Key));
+        for (const TSharedPtr<FJsonValue>& Value : Pair.Value->AsArray())
+        {
+            const int32 Line = (int32)Value->AsNumber();
+            if (Line < 0 || Line >= NumLines)
+                return false;
+            Lines.Add(Line);
+        }
+    }
+    return true;
+}
+
+void FDinkLineIndex::Build(const TMap<FName, FDinkBeat>& Beats)
+{
+    Reset();
+
+    Beats.GenerateKeyArray(LineIDs);
+    LineIDs.Sort(FNameLexicalLess());
+
+    // Walking the sorted LineIDs in order keeps every list sorted for free
+    for (int32 i = 0; i < LineIDs.Num(); ++i)
+    {
+        const FDinkBeat& Beat = Beats.FindChecked(LineIDs[i]);
+
+        if (Beat.Type == EDinkBeatType::Line && !Beat.CharacterID.IsNone())
+            CharacterLines.FindOrAdd(Beat.CharacterID).Add(i);
+
+        if (!Beat.SceneID.IsNone())
+            SceneLines.FindOrAdd(Beat.SceneID).Add(i);
+    }
+
+    for (auto& Pair : CharacterLines)
+        Pair.Value.Shrink();
+    for (auto& Pair : SceneLines)
+        Pair.Value.Shrink();
+}
+
+void FDinkLineIndex::Reset()
+{
+    LineIDs.Reset();
+    CharacterLines.Reset();
+    SceneLines.Reset();
+}
+
+void FDinkLineIndex::WriteJson(FJsonObject& JsonIndex) const
+{
+    TArray<TSharedPtr<FJsonValue>> JsonLineIDs;
+    JsonLineIDs.Reserve(LineIDs.Num());
+    for (const FName& LineID : LineIDs)
+        JsonLineIDs.Add(MakeShared<FJsonValueString>(LineID.ToString()));
+    JsonIndex.SetArrayField(TEXT("LineIDs"), JsonLineIDs);
+
+    TSharedRef<FJsonObject> JsonCharacters = MakeShared<FJsonObject>();
+    WriteJsonLists(CharacterLines, *JsonCharacters);
+    JsonIndex.SetObjectField(TEXT("Characters"), JsonCharacters);
+
+    TSharedRef<FJsonObject> JsonScenes = MakeShared<FJsonObject>();
+    WriteJsonLists(SceneLines, *JsonScenes);
+    JsonIndex.SetObjectField(TEXT("Scenes"), JsonScenes);
+}
+
+bool FDinkLineIndex::ReadJson(const FJsonObject& JsonIndex)
+{
+    Reset();
+
+    const TArray<TSharedPtr<FJsonValue>>* JsonLineIDs;
+    const TSharedPtr<FJsonObject>* JsonCharacters;
+    const TSharedPtr<FJsonObject>* JsonScenes;
+    if (!JsonIndex.TryGetArrayField(TEXT("LineIDs"), JsonLineIDs)
+        || !JsonIndex.TryGetObjectField(TEXT("Characters"), JsonCharacters)
+        || !JsonIndex.TryGetObjectField(TEXT("Scenes"), JsonScenes))
+        return false;
+
+    // Already sorted when it was written
+    LineIDs.Reserve(JsonLineIDs->Num());
+    for (const TSharedPtr<FJsonValue>& Value : *JsonLineIDs)
+        LineIDs.Add(FName(*Value->AsString()));
+
+    if (!ReadJsonLists(**JsonCharacters, LineIDs.Num(), CharacterLines)
+        || !ReadJsonLists(**JsonScenes, LineIDs.Num(), SceneLines))
+    {
+        Reset();
+        return false;
+    }
+    return true;
+}
+
+void FDinkLineIndex::GetLinesForCharacter(FName CharacterID, TArray<FName>& OutLineIDs) const
+{
+    if (const TArray<int32>* Lines = CharacterLines.Find(CharacterID))
+        AppendLineIDs(*Lines, OutLineIDs);
+}
+
+void FDinkLineIndex::GetLinesForScene(FName SceneID, TArray<FName>& OutLineIDs) const
+{
+    if (const TArray<int32>* Lines = SceneLines.Find(SceneID))
+        AppendLineIDs(*Lines, OutLineIDs);
+}
+
+void FDinkLineIndex::GetLinesForCharacterInScene(FName CharacterID, FName SceneID, TArray<FName>& OutLineIDs) const
+{
+    const TArray<int32>* CharLines = CharacterLines.Find(CharacterID);
+    const TArray<int32>* Lines = SceneLines.Find(SceneID);
+    if (!CharLines || !Lines)
+        return;
+
+    // Both lists are sorted, so a single merge pass finds the intersection
+    int32 a = 0;
+    int32 b = 0;
+    while (a < CharLines->Num() && b < Lines->Num())
+    {
+        const int32 Left = (*CharLines)[a];
+        const int32 Right = (*Lines)[b];
+        if (Left < Right)
+        {
+            ++a;
+        }
+        else if (Right < Left)
+        {
+            ++b;
+        }
+        else
+        {
+            OutLineIDs.Add(LineIDs[Left]);
+            ++a;
+            ++b;
+        }
+    }
+}
+
+void FDinkLineIndex::GetCharacterIDs(TArray<FName>& OutCharacterIDs) const
+{
+    CharacterLines.GetKeys(OutCharacterIDs);
+}
+
+void FDinkLineIndex::GetSceneIDs(TArray<FName>& OutSceneIDs) const
+{
+    SceneLines.GetKeys(OutSceneIDs);
+}
+
+SIZE_T FDinkLineIndex::GetAllocatedSize() const
+{
+    SIZE_T Size = LineIDs.GetAllocatedSize() + CharacterLines.GetAllocatedSize() + SceneLines.GetAllocatedSize();
+    for (const auto& Pair : CharacterLines)
+        Size += Pair.Value.GetAllocatedSize();
+    for (const auto& Pair : SceneLines)
+        Size += Pair.Value.GetAllocatedSize();
+    return Size;
+}
+
+void FDinkLineIndex::AppendLineIDs(const TArray<int32>& Lines, TArray<FName>& OutLineIDs) const
+{
+    OutLineIDs.Reserve(OutLineIDs.Num() + Lines.Num());
+    for (int32 Line : Lines)
+        OutLineIDs.Add(LineIDs[Line]);
+}
@@ -1,22 +1,103 @@
 #include "DinkRuntime.h"
+#include "Misc/StringBuilder.h"
 
 
-FString FDinkBeat::ToString() const
+void FDinkBeat::AppendString(FStringBuilderBase& Out) const
 {
-    FString dump = FString::Printf(TEXT("[%s] "), *LineID.ToString());
+    Out << TEXT("[") << LineID << TEXT("] ");
 
     if (Type == EDinkBeatType::Line) {
 
-        dump += FString::Printf(TEXT("Line | CharacterID: %s"), *CharacterID.ToString());
+        Out << TEXT("Line | CharacterID: ") << CharacterID;
 
-        if (!Qualifier.IsEmpty())
-            dump += FString::Printf(TEXT(" | Qualifier: %s"), *Qualifier);
+        if (!Qualifier.IsNone())
+            Out << TEXT(" | Qualifier: ") << Qualifier;
     }
     else if (Type == EDinkBeatType::Action)
     {
-        dump += FString::Printf(TEXT("Action"), *LineID.ToString());
-        dump += FString::Printf(TEXT(" | Text: \"%s\""), *Text);
+        Out << TEXT("Action");
+    }
+}
+
+FString FDinkBeat::ToString() const
+{
+    TStringBuilder<256> Builder;
+    AppendString(Builder);
+    return FString(Builder.ToView());
+}
+
+const FDinkBeat* FDinkRuntimeSnapshot::FindBeat(FName LineID) const
+{
+    if (RuntimeBeats.IsValid())
+    {
+        if (const FDinkBeat* Beat = RuntimeBeats->Beats.Find(LineID))
+            return Beat;
+    }
+
+    const FDinkRuntimeData* Chunk = FindChunkForLine(LineID);
+    return Chunk ? Chunk->Beats.Find(LineID) : nullptr;
+}
+
+const FString* FDinkRuntimeSnapshot::FindString(FName LineID) const
+{
+    if (RuntimeStrings.IsValid())
+    {
+        if (const FString* Text = RuntimeStrings->Find(LineID))
+            return Text;
+    }
+
+    if (RuntimeBeats.IsValid())
+    {
+        if (const FString* Text = RuntimeBeats->ActionText.Find(LineID))
+            return Text;
     }
 
-    return dump;
+    const FDinkRuntimeData* Chunk = FindChunkForLine(LineID);
+    if (!Chunk)
+        return nullptr;
+
+    const FString* Text = Chunk->Strings.Find(LineID);
+    return Text ? Text : Chunk->ActionText.Find(LineID);
+}
+
+void FDinkRuntimeSnapshot::ForEachLineIndex(TFunctionRef<void(const FDinkLineIndex&)> Func) const
+{
+    if (RuntimeBeats.IsValid())
+        Func(RuntimeBeats->LineIndex);
+
+    // A precomputed index covers every scene, resident or not
+    if (Manifest.IsValid() && Manifest->bHasLineIndex)
+    {
+        Func(Manifest->LineIndex);
+        return;
+    }
+
+    for (const auto& Pair : Chunks)
+        Func(Pair.Value->LineIndex);
+}
+
+const FDinkRuntimeData* FDinkRuntimeSnapshot::FindChunkForLine(FName LineID) const
+{
+    if (!Manifest.IsValid())
+        return nullptr;
+
+    const FName* SceneID = Manifest->LineScenes.Find(LineID);
+    const TSharedPtr<const FDinkRuntimeData>* Chunk = SceneID ? Chunks.Find(*SceneID) : nullptr;
+    return Chunk ? Chunk->Get() : nullptr;
+}
+
+SIZE_T FDinkBeatData::GetAllocatedSize() const
+{
+    SIZE_T Size = Beats.GetAllocatedSize() + ActionText.GetAllocatedSize() + LineIndex.GetAllocatedSize();
+    for (const auto& Pair : ActionText)
+        Size += Pair.Value.GetAllocatedSize();
+    return Size;
+}
+
+SIZE_T FDinkRuntimeData::GetAllocatedSize() const
+{
+    SIZE_T Size = FDinkBeatData::GetAllocatedSize() + Strings.GetAllocatedSize();
+    for (const auto& Pair : Strings)
+        Size += Pair.Value.GetAllocatedSize();
+    return Size;
 }
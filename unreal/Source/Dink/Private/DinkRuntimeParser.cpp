@@ -25,8 +25,12 @@ static FDinkBeat ParseMinimalBeat(const FName& LineID, TSharedPtr<FJsonObject> J
         Beat.Type = ParseBeatType(TypeStr);
     }
 
-    // Text (Usually only present for Action types in this format)
-    JsonBeat->TryGetStringField(TEXT("Text"), Beat.Text);
+    // SceneID
+    FString SceneIDStr;
+    if (JsonBeat->TryGetStringField(TEXT("SceneID"), SceneIDStr))
+    {
+        Beat.SceneID = FName(*SceneIDStr);
+    }
 
     // CharacterID
     FString CharIDStr;
@@ -36,34 +40,150 @@ static FDinkBeat ParseMinimalBeat(const FName& LineID, TSharedPtr<FJsonObject> J
     }
 
     // Qualifier
-    JsonBeat->TryGetStringField(TEXT("Qualifier"), Beat.Qualifier);
+    Beat.Qualifier = UDinkRuntimeParser::ParseNameField(*JsonBeat, TEXT("Qualifier"));
 
     return Beat;
 }
 
-bool UDinkRuntimeParser::ParseJSON(const FString& JsonRaw, TMap<FName, FDinkBeat>& OutBeats)
+FName UDinkRuntimeParser::ParseNameField(const FJsonObject& JsonObject, const TCHAR* FieldName)
+{
+    FString Value;
+    if (JsonObject.TryGetStringField(FieldName, Value) && !Value.IsEmpty())
+    {
+        return FName(*Value);
+    }
+    return NAME_None;
+}
+
+bool UDinkRuntimeParser::ParseJSON(const FString& JsonRaw, TMap<FName, FDinkBeat>& OutBeats, TMap<FName, FString>& OutActionText)
 {
     TSharedRef<TJsonReader<>> Reader = TJsonReaderFactory<>::Create(JsonRaw);
     TSharedPtr<FJsonObject> JsonRootObject;
 
     if (FJsonSerializer::Deserialize(Reader, JsonRootObject) && JsonRootObject.IsValid())
     {
-        for (auto It = JsonRootObject->Values.CreateConstIterator(); It; ++It)
+        ParseBeats(*JsonRootObject, OutBeats, OutActionText);
+        return true;
+    }
+
+    UE_LOG(LogDink, Error, TEXT("Failed to deserialize Dink runtime JSON."));
+    return false;
+}
+
+void UDinkRuntimeParser::ParseBeats(const FJsonObject& JsonRoot, TMap<FName, FDinkBeat>& OutBeats, TMap<FName, FString>& OutActionText)
+{
+    OutBeats.Reserve(OutBeats.Num() + JsonRoot.Values.Num());
+    for (auto It = JsonRoot.Values.CreateConstIterator(); It; ++It)
+    {
+        const FString& KeyLineID = It.Key();
+        const TSharedPtr<FJsonValue>& Value = It.Value();
+
+        TSharedPtr<FJsonObject> BeatObj = Value->AsObject();
+        if (BeatObj.IsValid())
         {
-            const FString& KeyLineID = It.Key();
-            const TSharedPtr<FJsonValue>& Value = It.Value();
+            FName LineIDName = FName(*KeyLineID);
+            FDinkBeat Beat = ParseMinimalBeat(LineIDName, BeatObj);
+            OutBeats.Add(LineIDName, Beat);
+
+            // Only present for actions, and only if they aren't localised
+            FString Text;
+            if (BeatObj->TryGetStringField(TEXT("Text"), Text))
+                OutActionText.Add(LineIDName, MoveTemp(Text));
+        }
+    }
+}
+
+bool UDinkRuntimeParser::ParseStringsJSON(const FString& JsonRaw, TMap<FName, FString>& OutStrings)
+{
+    TSharedRef<TJsonReader<>> Reader = TJsonReaderFactory<>::Create(JsonRaw);
+    TSharedPtr<FJsonObject> JsonRootObject;
 
-            TSharedPtr<FJsonObject> BeatObj = Value->AsObject();
-            if (BeatObj.IsValid())
+    if (FJsonSerializer::Deserialize(Reader, JsonRootObject) && JsonRootObject.IsValid())
+    {
+        OutStrings.Reserve(OutStrings.Num() + JsonRootObject->Values.Num());
+        for (auto It = JsonRootObject->Values.CreateConstIterator(); It; ++It)
+        {
+            FString Text;
+            if (It.Value()->TryGetString(Text))
             {
-                FName LineIDName = FName(*KeyLineID);
-                FDinkBeat Beat = ParseMinimalBeat(LineIDName, BeatObj);
-                OutBeats.Add(LineIDName, Beat);
+                OutStrings.Add(FName(*It.Key()), MoveTemp(Text));
             }
         }
         return true;
     }
 
-    UE_LOG(LogDink, Error, TEXT("Failed to deserialize Dink runtime JSON."));
+    UE_LOG(LogDink, Error, TEXT("Failed to deserialize Dink strings JSON."));
     return false;
-}
\ No newline at end of file
+}
+
+bool UDinkRuntimeParser::ParseManifestJSON(const FString& JsonRaw, const FString& Locale, FDinkChunkManifest& OutManifest)
+{
+    TSharedRef<TJsonReader<>> Reader = TJsonReaderFactory<>::Create(JsonRaw);
+    TSharedPtr<FJsonObject> JsonRootObject;
+
+    if (!FJsonSerializer::Deserialize(Reader, JsonRootObject) || !JsonRootObject.IsValid())
+    {
+        UE_LOG(LogDink, Error, TEXT("Failed to deserialize Dink chunk manifest JSON."));
+        return false;
+    }
+
+    OutManifest.Locale = Locale;
+    const TArray<TSharedPtr<FJsonValue>>* LocalesArray;
+    if (OutManifest.Locale.IsEmpty() && JsonRootObject->TryGetArrayField(TEXT("Locales"), LocalesArray) && LocalesArray->Num() > 0)
+    {
+        OutManifest.Locale = (*LocalesArray)[0]->AsString();
+    }
+
+    const TSharedPtr<FJsonObject>* CommonStringsObj;
+    if (JsonRootObject->TryGetObjectField(TEXT("CommonStrings"), CommonStringsObj))
+    {
+        (*CommonStringsObj)->TryGetStringField(OutManifest.Locale, OutManifest.CommonStringsFile);
+    }
+
+    const TSharedPtr<FJsonObject>* ScenesObj;
+    if (JsonRootObject->TryGetObjectField(TEXT("Scenes"), ScenesObj))
+    {
+        for (auto It = (*ScenesObj)->Values.CreateConstIterator(); It; ++It)
+        {
+            TSharedPtr<FJsonObject> SceneObj = It.Value()->AsObject();
+            if (!SceneObj.IsValid())
+                continue;
+
+            FName SceneID = FName(*It.Key());
+
+            FString DinkFile;
+            if (SceneObj->TryGetStringField(TEXT("Dink"), DinkFile))
+            {
+                OutManifest.DinkFiles.Add(SceneID, DinkFile);
+            }
+
+            const TSharedPtr<FJsonObject>* StringsObj;
+            FString StringsFile;
+            if (SceneObj->TryGetObjectField(TEXT("Strings"), StringsObj) && (*StringsObj)->TryGetStringField(OutManifest.Locale, StringsFile))
+            {
+                OutManifest.StringsFiles.Add(SceneID, StringsFile);
+            }
+        }
+    }
+
+    const TSharedPtr<FJsonObject>* LinesObj;
+    if (JsonRootObject->TryGetObjectField(TEXT("Lines"), LinesObj))
+    {
+        OutManifest.LineScenes.Reserve((*LinesObj)->Values.Num());
+        for (auto It = (*LinesObj)->Values.CreateConstIterator(); It; ++It)
+        {
+            OutManifest.LineScenes.Add(FName(*It.Key()), FName(*It.Value()->AsString()));
+        }
+    }
+
+    const TSharedPtr<FJsonObject>* IndexObj;
+    if (JsonRootObject->TryGetObjectField(TEXT("Index"), IndexObj))
+    {
+        OutManifest.bHasLineIndex = OutManifest.LineIndex.ReadJson(**IndexObj);
+        if (!OutManifest.bHasLineIndex)
+        {
+            UE_LOG(LogDink, Warning, TEXT("Ignoring malformed line index in Dink chunk manifest."));
+        }
+    }
+    return true;
+}
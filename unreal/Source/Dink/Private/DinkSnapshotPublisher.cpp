@@ -0,0 +1,102 @@
+#include "DinkSnapshotPublisher.h"
+#include "DinkRuntime.h"
+#include "Misc/ScopeLock.h"
+
+FDinkSnapshotPublisher::FDinkSnapshotPublisher()
+    : Current(new FDinkRuntimeSnapshot())
+    , Epoch(0)
+    , DrainedEpoch(0)
+{
+    for (FReaderSlot& ReaderSlot : ReaderSlots)
+    {
+        ReaderSlot.Count[0] = 0;
+        ReaderSlot.Count[1] = 0;
+    }
+}
+
+FDinkSnapshotPublisher::~FDinkSnapshotPublisher()
+{
+    for (const FRetiredSnapshot& RetiredSnapshot : Retired)
+        delete RetiredSnapshot.Snapshot;
+
+    delete Current.load();
+}
+
+uint32 FDinkSnapshotPublisher::GetReaderSlot()
+{
+    static std::atomic<uint32> NextSlot(0);
+    static thread_local uint32 Slot = NextSlot.fetch_add(1) % NumReaderSlots;
+    return Slot;
+}
+
+bool FDinkSnapshotPublisher::IsDrained(uint32 Parity) const
+{
+    for (const FReaderSlot& ReaderSlot : ReaderSlots)
+    {
+        if (ReaderSlot.Count[Parity].load() != 0)
+            return false;
+    }
+    return true;
+}
+
+void FDinkSnapshotPublisher::Read(TFunctionRef<void(const FDinkRuntimeSnapshot&)> Func) const
+{
+    std::atomic<int32>* Counts = ReaderSlots[GetReaderSlot()].Count;
+    const uint32 Parity = Epoch.load() & 1;
+    Counts[Parity].fetch_add(1);
+    Func(*Current.load());
+    Counts[Parity].fetch_sub(1);
+}
+
+void FDinkSnapshotPublisher::Publish(TUniquePtr<FDinkRuntimeSnapshot> Snapshot)
+{
+    FScopeLock Lock(&PublishLock);
+
+    FDinkRuntimeSnapshot* Old = Current.exchange(Snapshot.Release());
+    Retired.Add({ Old, Epoch.load() });
+
+    FreeDrained();
+}
+
+void FDinkSnapshotPublisher::Reclaim()
+{
+    FScopeLock Lock(&PublishLock);
+    FreeDrained();
+}
+
+void FDinkSnapshotPublisher::FreeDrained()
+{
+    if (Retired.IsEmpty())
+        return;
+
+    // A snapshot retired in epoch E is freed once the epoch has moved on
+    // twice and both parities have drained since. A reader that picked its
+    // epoch before an earlier flip can register late, in the parity the first
+    // drain didn't cover, and still pick up the old snapshot.
+    const uint32 NeededEpoch = Retired.Last().Epoch + 2;
+    while (DrainedEpoch < NeededEpoch)
+    {
+        const uint32 CurrentEpoch = Epoch.load();
+        if (DrainedEpoch < CurrentEpoch)
+        {
+            // Still readers in the epoch before this one, try again later
+            if (!IsDrained((CurrentEpoch - 1) & 1))
+                break;
+
+            DrainedEpoch = CurrentEpoch;
+        }
+        else
+        {
+            // New readers go to the other parity, so the one we're leaving can drain
+            Epoch.fetch_add(1);
+        }
+    }
+
+    Retired.RemoveAll([this](const FRetiredSnapshot& RetiredSnapshot) {
+        if (DrainedEpoch < RetiredSnapshot.Epoch + 2)
+            return false;
+
+        delete RetiredSnapshot.Snapshot;
+        return true;
+    });
+}
@@ -1,62 +1,89 @@
 #include "DinkStructure.h"
+#include "Misc/StringBuilder.h"
 
-FString FDinkStructureBeat::ToString() const
+void FDinkStructureBeat::AppendString(FStringBuilderBase& Out) const
 {
-    FString dump = FString::Printf(TEXT("[%s] "), *LineID.ToString());
+    Out << TEXT("[") << LineID << TEXT("] ");
 
     if (Type == EDinkBeatType::Line) {
 
-        dump += FString::Printf(TEXT("Line | CharacterID: %s"), *CharacterID.ToString());
+        Out << TEXT("Line | CharacterID: ") << CharacterID;
 
-        if (!Qualifier.IsEmpty())
-            dump += FString::Printf(TEXT(" | Qualifier: %s"), *Qualifier);
+        if (!Qualifier.IsNone())
+            Out << TEXT(" | Qualifier: ") << Qualifier;
 
         if (!Direction.IsEmpty())
-            dump += FString::Printf(TEXT(" | Direction: %s"), *Direction);
+            Out << TEXT(" | Direction: ") << Direction;
     }
     else if (Type == EDinkBeatType::Action)
     {
-        dump += FString::Printf(TEXT("Action"), *LineID.ToString());
+        Out << TEXT("Action");
     }
 
-    dump += FString::Printf(TEXT(" | Text: \"%s\""), *Text);
+    Out << TEXT(" | Text: \"") << Text << TEXT("\"");
 
     if (Tags.Num() > 0)
     {
-        dump += TEXT(" | Tags:");
+        Out << TEXT(" | Tags:");
         for (const FString& tag : Tags)
-            dump += FString::Printf(TEXT(" #%s"), *tag);
+            Out << TEXT(" #") << tag;
     }
+}
 
-    return dump;
+FString FDinkStructureBeat::ToString() const
+{
+    TStringBuilder<256> Builder;
+    AppendString(Builder);
+    return FString(Builder.ToView());
 }
 
-FString FDinkStructureSnippet::ToString() const
+void FDinkStructureSnippet::AppendString(FStringBuilderBase& Out) const
 {
-    FString dump = FString::Printf(TEXT("  Snippet:%s Beats:%d"), *SnippetID.ToString(), Beats.Num());
+    Out << TEXT("  Snippet:") << SnippetID << TEXT(" Beats:") << Beats.Num();
     for (const FDinkStructureBeat& beat : Beats)
     {
-        dump += FString::Printf(TEXT("\n    %s"), *beat.ToString());
+        Out << TEXT("\n    ");
+        beat.AppendString(Out);
     }
-    return dump;
 }
 
-FString FDinkStructureBlock::ToString() const
+FString FDinkStructureSnippet::ToString() const
+{
+    TStringBuilder<1024> Builder;
+    AppendString(Builder);
+    return FString(Builder.ToView());
+}
+
+void FDinkStructureBlock::AppendString(FStringBuilderBase& Out) const
 {
-    FString dump = FString::Printf(TEXT("  Block:%s Snippets:%d"), *BlockID.ToString(), Snippets.Num());
+    Out << TEXT("  Block:") << BlockID << TEXT(" Snippets:") << Snippets.Num();
     for (const FDinkStructureSnippet& snippet : Snippets)
     {
-        dump += FString::Printf(TEXT("\n        %s"), *snippet.ToString());
+        Out << TEXT("\n        ");
+        snippet.AppendString(Out);
     }
-    return dump;
 }
 
-FString FDinkStructureScene::ToString() const
+FString FDinkStructureBlock::ToString() const
+{
+    TStringBuilder<1024> Builder;
+    AppendString(Builder);
+    return FString(Builder.ToView());
+}
+
+void FDinkStructureScene::AppendString(FStringBuilderBase& Out) const
 {
-    FString dump = FString::Printf(TEXT("Scene:%s Blocks:%d"), *SceneID.ToString(), Blocks.Num());
+    Out << TEXT("Scene:") << SceneID << TEXT(" Blocks:") << Blocks.Num();
     for (const FDinkStructureBlock& block : Blocks)
     {
-        dump += FString::Printf(TEXT("\n%s"), *block.ToString());
+        Out << TEXT("\n");
+        block.AppendString(Out);
     }
-    return dump;
-}
\ No newline at end of file
+}
+
+FString FDinkStructureScene::ToString() const
+{
+    TStringBuilder<4096> Builder;
+    AppendString(Builder);
+    return FString(Builder.ToView());
+}
@@ -3,6 +3,8 @@
 #include "Logging/LogMacros.h"
 #include "CoreMinimal.h"
 #include "Modules/ModuleManager.h"
+#include "Containers/Ticker.h"
+#include "DinkSnapshotPublisher.h"
 #include "Dink.generated.h"
 
 UENUM(BlueprintType)
@@ -12,6 +14,48 @@ enum class EDinkBeatType : uint8
 	Action  UMETA(DisplayName = "Action")
 };
 
+UENUM(BlueprintType)
+enum class EDinkSceneRequest : uint8
+{
+	Resident  UMETA(DisplayName = "Resident"),
+	Pending   UMETA(DisplayName = "Pending"),
+	Failed    UMETA(DisplayName = "Failed")
+};
+
+struct FDinkBeat;
+struct FDinkBeatData;
+struct FDinkRuntimeData;
+struct FDinkChunkManifest;
+struct FDinkRuntimeSnapshot;
+
+// One scene's runtime data, streamed in from its chunk files
+struct FDinkResidentChunk
+{
+	TSharedPtr<FDinkRuntimeData> Data;
+	SIZE_T AllocatedSize = 0;
+
+	// Outstanding RequestScene calls. Only unreferenced chunks can be evicted.
+	int32 RefCount = 0;
+
+	// Higher is more recently used
+	uint64 LastUsed = 0;
+};
+
+// A scene whose chunk is being read and parsed on a worker thread
+struct FDinkPendingChunk
+{
+	// RequestScene calls made while it loads, handed on to the chunk
+	int32 RefCount = 0;
+
+	// Called once it's resident, or has failed
+	TArray<TFunction<void(bool)>> OnLoaded;
+};
+
+DECLARE_DYNAMIC_DELEGATE_TwoParams(FOnDinkSceneLoaded, FName, SceneID, bool, bSuccess);
+
+// Fired with every LineID a consumer should warm up (voice, facial animation etc.) for an upcoming scene.
+DECLARE_MULTICAST_DELEGATE_TwoParams(FOnDinkPrefetchLines, FName /*SceneID*/, const TArray<FName>& /*LineIDs*/);
+
 UCLASS()
 class DINK_API UDink : public UEngineSubsystem
 {
@@ -21,10 +65,119 @@ public:
 	UDink();
 
 	virtual void Initialize(FSubsystemCollectionBase&) override;
+	virtual void Deinitialize() override;
 	void Register();
 	static UDink* Get();
 
+	// Replaces the loaded runtime beats and rebuilds the line index. Strings
+	// are left as they are. Drops any chunked data, as LoadChunkManifest
+	// drops these beats.
+	bool LoadRuntime(const FString& JsonRaw);
+
+	// Replaces the loaded runtime strings.
+	bool LoadStrings(const FString& JsonRaw);
+
+	// Switches to chunked data. Only the manifest and the common strings are
+	// loaded up front: each scene's beats and strings are streamed in by
+	// RequestScene. An empty Locale picks the first one in the manifest.
+	UFUNCTION(BlueprintCallable, Category = "Dink")
+	bool LoadChunkManifest(const FString& ManifestFile, const FString& Locale = TEXT(""));
+
+	// Makes sure a scene's chunk is resident, and keeps it so until the
+	// matching ReleaseScene. If it isn't resident yet, it's read and parsed on
+	// a worker thread and this returns Pending; OnLoaded then fires on the
+	// game thread once it's in. Otherwise OnLoaded fires straight away.
+	// Scenes loaded whole with LoadRuntime are always Resident.
+	// Pending requests fail if LoadRuntime or LoadChunkManifest replace the
+	// data before they complete. A request that fails (Failed, or OnLoaded
+	// with bSuccess false) isn't held, so mustn't be matched by ReleaseScene.
+	UFUNCTION(BlueprintCallable, Category = "Dink", meta = (AutoCreateRefTerm = "OnLoaded"))
+	EDinkSceneRequest RequestScene(FName SceneID, const FOnDinkSceneLoaded& OnLoaded);
+
+	// Once a scene has no outstanding requests its chunk can be evicted,
+	// least recently used first, when unrequested chunks go over the memory
+	// budget.
+	UFUNCTION(BlueprintCallable, Category = "Dink")
+	void ReleaseScene(FName SceneID);
+
+	UFUNCTION(BlueprintCallable, Category = "Dink")
+	bool IsSceneResident(FName SceneID) const;
+
+	// Runs Func against the data as it is right now. Safe from any thread and
+	// never blocks, even while data is being loaded or evicted. Pointers into
+	// the snapshot are only valid until Func returns. Func can load, request
+	// or release, but won't see the result until it's called again.
+	void ReadSnapshot(TFunctionRef<void(const FDinkRuntimeSnapshot&)> Func) const;
+
+	// Lookups only see data that's resident: the whole file if loaded with
+	// LoadRuntime, otherwise the common strings and resident scene chunks.
+	// The line queries below also cover non-resident scenes if the manifest
+	// came with a precomputed index. All of them copy out, so are safe from
+	// any thread.
+	bool FindBeat(FName LineID, FDinkBeat& OutBeat) const;
+
+	// Also finds the text of action beats that aren't localised.
+	bool FindString(FName LineID, FString& OutText) const;
+
+	UFUNCTION(BlueprintCallable, Category = "Dink")
+	TArray<FName> GetLinesForCharacter(FName CharacterID) const;
+
+	UFUNCTION(BlueprintCallable, Category = "Dink")
+	TArray<FName> GetLinesForScene(FName SceneID) const;
+
+	UFUNCTION(BlueprintCallable, Category = "Dink")
+	TArray<FName> GetLinesForCharacterInScene(FName CharacterID, FName SceneID) const;
+
+	// Broadcasts OnPrefetchLines with all the lines in a scene, optionally
+	// narrowed to one character. Streams the scene's chunk in if needed. The
+	// broadcast waits for the chunk unless the manifest has a precomputed index.
+	UFUNCTION(BlueprintCallable, Category = "Dink")
+	void PrefetchScene(FName SceneID, FName CharacterID = NAME_None);
+
+	FOnDinkPrefetchLines OnPrefetchLines;
+
 private:
+	// Starts streaming a scene's chunk in on a worker thread, unless it's
+	// resident already. OnLoaded is only kept if this returns Pending.
+	EDinkSceneRequest StreamChunk(FName SceneID, bool bAddRef, TFunction<void(bool)> OnLoaded);
+
+	// Reads and parses a scene's chunk files. Touches no UDink state, so runs on worker threads.
+	static TSharedPtr<FDinkRuntimeData> ReadChunk(const FDinkChunkManifest& FromManifest, FName SceneID);
+
+	// Back on the game thread: makes the chunk resident and runs its callbacks.
+	void FinishChunk(FName SceneID, const TSharedPtr<const FDinkChunkManifest>& FromManifest, const TSharedPtr<FDinkRuntimeData>& Data);
+
+	// Drops every chunk, resident or pending. Call with WriteLock held, then
+	// fail the returned callbacks once it's released.
+	TArray<TFunction<void(bool)>> ResetChunks();
+
+	// Returns whether anything was evicted.
+	bool EvictChunks();
+
+	void BroadcastPrefetch(FName SceneID, FName CharacterID) const;
+
+	// Publishes the current writer state for readers. Call with WriteLock held.
+	void PublishSnapshot();
+
+	FDinkSnapshotPublisher Snapshots;
+
+	// Frees the snapshots readers have finished with, between publishes
+	FTSTicker::FDelegateHandle ReclaimTicker;
+
+	// Everything below is writer state, only touched under WriteLock. Readers
+	// go through Snapshots instead.
+	FCriticalSection WriteLock;
+
+	// Data that stays resident. Beats and strings are kept apart so either
+	// can be reloaded without copying the other. When chunked, there are no
+	// whole-file beats and the strings are the common ones.
+	TSharedPtr<const FDinkBeatData> RuntimeBeats;
+	TSharedPtr<const TMap<FName, FString>> RuntimeStrings;
+
+	TSharedPtr<const FDinkChunkManifest> Manifest;
+	TMap<FName, FDinkResidentChunk> Chunks;
+	TMap<FName, FDinkPendingChunk> PendingChunks;
+	uint64 ChunkUseCounter = 0;
 };
 
 class FDinkModule : public IModuleInterface
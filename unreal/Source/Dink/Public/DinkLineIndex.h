@@ -0,0 +1,43 @@
+#pragma once
+
+#include "CoreMinimal.h"
+
+struct FDinkBeat;
+class FJsonObject;
+
+// Inverted index over the runtime beats, built once at load, so queries like
+// "every line for this character in this scene" don't walk the whole beat map.
+struct DINK_API FDinkLineIndex
+{
+public:
+    void Build(const TMap<FName, FDinkBeat>& Beats);
+    void Reset();
+
+    // Lets the index be built at cook time and loaded as-is at runtime.
+    void WriteJson(FJsonObject& JsonIndex) const;
+    bool ReadJson(const FJsonObject& JsonIndex);
+
+    // All queries append LineIDs in lexical order.
+    void GetLinesForCharacter(FName CharacterID, TArray<FName>& OutLineIDs) const;
+    void GetLinesForScene(FName SceneID, TArray<FName>& OutLineIDs) const;
+    void GetLinesForCharacterInScene(FName CharacterID, FName SceneID, TArray<FName>& OutLineIDs) const;
+
+    void GetCharacterIDs(TArray<FName>& OutCharacterIDs) const;
+    void GetSceneIDs(TArray<FName>& OutSceneIDs) const;
+
+    bool HasScene(FName SceneID) const { return SceneLines.Contains(SceneID); }
+
+    int32 Num() const { return LineIDs.Num(); }
+
+    SIZE_T GetAllocatedSize() const;
+
+private:
+    void AppendLineIDs(const TArray<int32>& Lines, TArray<FName>& OutLineIDs) const;
+
+    // Every LineID, sorted lexically. The per-character and per-scene
+    // lists hold ascending indices into this array.
+    TArray<FName> LineIDs;
+
+    TMap<FName, TArray<int32>> CharacterLines;
+    TMap<FName, TArray<int32>> SceneLines;
+};
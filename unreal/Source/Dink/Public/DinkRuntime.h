@@ -2,6 +2,7 @@
 
 #include "CoreMinimal.h"
 #include "Dink.h"
+#include "DinkLineIndex.h"
 #include "DinkRuntime.generated.h"
 
 USTRUCT(BlueprintType)
@@ -16,12 +17,9 @@ public:
     UPROPERTY(BlueprintReadOnly, VisibleAnywhere, Category = "Dink")
     FName LineID;
 
-    // This applies only to Action type, if actions aren't localised
-    // BEGIN ACTION TYPE
+    // The scene (Ink knot) the beat belongs to
     UPROPERTY(BlueprintReadOnly, VisibleAnywhere, Category = "Dink")
-    FString Text;
-
-    // END ACTION TYPE
+    FName SceneID;
 
     // These apply only to Line type
     // BEGIN LINE TYPE
@@ -29,10 +27,90 @@ public:
     UPROPERTY(BlueprintReadOnly, VisibleAnywhere, Category = "Dink")
     FName CharacterID;
 
+    // Qualifiers come from a tiny vocabulary ("O.S.", "V.O."), so they're
+    // interned as names. None if the line has no qualifier.
     UPROPERTY(BlueprintReadOnly, VisibleAnywhere, Category = "Dink")
-    FString Qualifier;
+    FName Qualifier;
 
     // END LINE TYPE
 
+    // Appends the debug dump to an existing builder without any temporary allocations.
+    void AppendString(FStringBuilderBase& Out) const;
     FString ToString() const;
 };
+
+// Beats loaded from a Dink runtime file (or one scene chunk of it),
+// plus the index built over them.
+struct DINK_API FDinkBeatData
+{
+    TMap<FName, FDinkBeat> Beats;
+
+    // Text of action beats that aren't localised. Only a few beats have any,
+    // so it's kept out of FDinkBeat rather than every beat paying for it.
+    TMap<FName, FString> ActionText;
+
+    FDinkLineIndex LineIndex;
+
+    SIZE_T GetAllocatedSize() const;
+};
+
+// One scene's chunk: its beats and strings are streamed in together.
+struct DINK_API FDinkRuntimeData : public FDinkBeatData
+{
+    // LineID to display text, from the strings file for the current locale
+    TMap<FName, FString> Strings;
+
+    SIZE_T GetAllocatedSize() const;
+};
+
+// Where each scene's chunk of runtime data lives, as written by
+// UDinkChunkWriter in the editor.
+struct DINK_API FDinkChunkManifest
+{
+    // Folder the chunk files are relative to
+    FString BaseDir;
+
+    FString Locale;
+
+    // SceneID to chunk file names
+    TMap<FName, FString> DinkFiles;
+    TMap<FName, FString> StringsFiles;
+
+    // Strings that don't belong to any scene's beats e.g. non-Dink Ink lines.
+    // These stay resident.
+    FString CommonStringsFile;
+
+    // LineID to the SceneID whose chunk holds it
+    TMap<FName, FName> LineScenes;
+
+    // Line index over every scene, precomputed at cook time. When present,
+    // chunks don't build their own as they stream in.
+    FDinkLineIndex LineIndex;
+    bool bHasLineIndex = false;
+};
+
+// An immutable view of everything resident at one moment, published by UDink.
+// Nothing in it changes after publication, so any thread can read it freely.
+struct DINK_API FDinkRuntimeSnapshot
+{
+    // The whole runtime file's beats, from LoadRuntime. Kept apart from the
+    // strings so that reloading either never copies the other.
+    TSharedPtr<const FDinkBeatData> RuntimeBeats;
+
+    // The whole strings file, or just the common strings when chunked
+    TSharedPtr<const TMap<FName, FString>> RuntimeStrings;
+
+    TSharedPtr<const FDinkChunkManifest> Manifest;
+
+    // SceneID to resident chunk
+    TMap<FName, TSharedPtr<const FDinkRuntimeData>> Chunks;
+
+    const FDinkBeat* FindBeat(FName LineID) const;
+    const FString* FindString(FName LineID) const;
+
+    // The precomputed manifest index if there is one, otherwise each resident index
+    void ForEachLineIndex(TFunctionRef<void(const FDinkLineIndex&)> Func) const;
+
+private:
+    const FDinkRuntimeData* FindChunkForLine(FName LineID) const;
+};
@@ -4,12 +4,28 @@
 #include "DinkRuntimeParser.generated.h"
 
 struct FDinkBeat;
+struct FDinkChunkManifest;
+class FJsonObject;
 
 UCLASS()
 class DINK_API UDinkRuntimeParser : public UBlueprintFunctionLibrary
 {
     GENERATED_BODY()
 public:
+    // OutActionText gets the text of action beats that aren't localised.
     UFUNCTION(BlueprintCallable, Category = "Dink")
-    static bool ParseJSON(const FString& JsonRaw, TMap<FName, FDinkBeat>& OutBeats);
+    static bool ParseJSON(const FString& JsonRaw, TMap<FName, FDinkBeat>& OutBeats, TMap<FName, FString>& OutActionText);
+
+    // For callers that already have the runtime file deserialized.
+    static void ParseBeats(const FJsonObject& JsonRoot, TMap<FName, FDinkBeat>& OutBeats, TMap<FName, FString>& OutActionText);
+
+    UFUNCTION(BlueprintCallable, Category = "Dink")
+    static bool ParseStringsJSON(const FString& JsonRaw, TMap<FName, FString>& OutStrings);
+
+    // For short, repetitive fields that are interned as names. Empty or
+    // missing strings become NAME_None, so absent fields cost nothing.
+    static FName ParseNameField(const FJsonObject& JsonObject, const TCHAR* FieldName);
+
+    // An empty Locale picks the first one listed in the manifest.
+    static bool ParseManifestJSON(const FString& JsonRaw, const FString& Locale, FDinkChunkManifest& OutManifest);
 };
\ No newline at end of file
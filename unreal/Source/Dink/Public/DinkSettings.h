@@ -0,0 +1,36 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Engine/DeveloperSettings.h"
+#include "DinkSettings.generated.h"
+
+/**
+ * Runtime settings for Dink.
+ */
+UCLASS(Config = Dink, defaultconfig, meta = (DisplayName = "Dink Settings"))
+class DINK_API UDinkSettings : public UDeveloperSettings
+{
+    GENERATED_BODY()
+
+public:
+    // SETTINGS CONFIGURATION
+    // -------------------------------------------------
+
+    virtual FName GetCategoryName() const override { return FName("Plugins"); }
+
+    virtual FName GetSectionName() const override { return FName("DinkRuntime"); }
+
+    // SETTINGS PROPERTIES
+    // -------------------------------------------------
+
+    // Chunk manifest written at cook time, relative to the project's Content folder
+    // e.g. Dink/MyGame-dink-manifest.json. It covers every root Ink file. If set,
+    // it's loaded on startup and scene data is streamed in by RequestScene.
+    UPROPERTY(Config, EditAnywhere, BlueprintReadOnly, Category = "Chunks")
+    FString ChunkManifestPath;
+
+    // How much memory scene chunks that nobody has requested can hold on to
+    // before the least recently used ones are evicted.
+    UPROPERTY(Config, EditAnywhere, BlueprintReadOnly, Category = "Chunks", meta = (ClampMin = "0"))
+    int32 ChunkBudgetKB = 4096;
+};
@@ -0,0 +1,77 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "HAL/CriticalSection.h"
+#include <atomic>
+
+struct FDinkRuntimeSnapshot;
+
+// Hands immutable FDinkRuntimeSnapshots to readers on any thread, RCU style.
+// Readers never take a lock or wait: they bump their own thread's counter for
+// the current epoch, use whatever snapshot is published, and drop the counter
+// again. Publishing never waits either: it swaps in the new snapshot and
+// retires the old one, which is freed by a later Publish or Reclaim once no
+// reader can still see it.
+class DINK_API FDinkSnapshotPublisher
+{
+public:
+    FDinkSnapshotPublisher();
+    ~FDinkSnapshotPublisher();
+
+    FDinkSnapshotPublisher(const FDinkSnapshotPublisher&) = delete;
+    FDinkSnapshotPublisher& operator=(const FDinkSnapshotPublisher&) = delete;
+
+    // The snapshot is only guaranteed to live until Func returns. Publishing
+    // from inside Func is fine, but holds up reclaiming until Func returns.
+    void Read(TFunctionRef<void(const FDinkRuntimeSnapshot&)> Func) const;
+
+    void Publish(TUniquePtr<FDinkRuntimeSnapshot> Snapshot);
+
+    // Frees any retired snapshots that readers have finished with. Publish
+    // does this too; call it periodically so they don't wait for the next one.
+    void Reclaim();
+
+private:
+    // Threads are handed slots round robin, so readers only share a counter
+    // (and its cache line) once there are more threads than slots.
+    static constexpr int32 NumReaderSlots = 64;
+
+    struct alignas(PLATFORM_CACHE_LINE_SIZE) FReaderSlot
+    {
+        // Readers in each of the two epochs
+        std::atomic<int32> Count[2];
+    };
+
+    static uint32 GetReaderSlot();
+
+    // Whether no reader is registered in the given epoch parity right now
+    bool IsDrained(uint32 Parity) const;
+
+    // Moves the epoch on as far as readers allow and frees what that makes
+    // safe. Call with PublishLock held.
+    void FreeDrained();
+
+    struct FRetiredSnapshot
+    {
+        FDinkRuntimeSnapshot* Snapshot;
+
+        // Epoch when it was swapped out
+        uint32 Epoch;
+    };
+
+    mutable FReaderSlot ReaderSlots[NumReaderSlots];
+
+    // Only written under PublishLock, so readers just share these read-only
+    alignas(PLATFORM_CACHE_LINE_SIZE) std::atomic<FDinkRuntimeSnapshot*> Current;
+    std::atomic<uint32> Epoch;
+
+    // Publishers queue up behind each other, never behind readers. Everything
+    // below is only touched under it.
+    FCriticalSection PublishLock;
+
+    // The latest epoch whose previous parity has drained since it was entered.
+    // The epoch only moves on once that's happened.
+    uint32 DrainedEpoch;
+
+    TArray<FRetiredSnapshot> Retired;
+};
@@ -28,14 +28,19 @@ public:
     UPROPERTY(BlueprintReadOnly, VisibleAnywhere, Category = "Dink")
     FName CharacterID;
 
+    // Interned as a name, None if absent
     UPROPERTY(BlueprintReadOnly, VisibleAnywhere, Category = "Dink")
-    FString Qualifier;
+    FName Qualifier;
 
+    // Free-form stage direction, so it stays a string
     UPROPERTY(BlueprintReadOnly, VisibleAnywhere, Category = "Dink")
     FString Direction;
 
     // END LINE TYPE
 
+    // Appends the debug dump to an existing builder, so nested dumps of whole
+    // scenes only ever grow one buffer.
+    void AppendString(FStringBuilderBase& Out) const;
     FString ToString() const;
 };
 
@@ -52,6 +57,7 @@ public:
     UPROPERTY(BlueprintReadOnly, VisibleAnywhere, Category = "Dink")
     TArray<FDinkStructureBeat> Beats;
 
+    void AppendString(FStringBuilderBase& Out) const;
     FString ToString() const;
 };
 
@@ -68,6 +74,7 @@ public:
     UPROPERTY(BlueprintReadOnly, VisibleAnywhere, Category = "Dink")
     TArray<FDinkStructureSnippet> Snippets;
 
+    void AppendString(FStringBuilderBase& Out) const;
     FString ToString() const;
 };
 
@@ -84,5 +91,6 @@ public:
     UPROPERTY(BlueprintReadOnly, VisibleAnywhere, Category = "Dink")
     TArray<FDinkStructureBlock> Blocks;
 
+    void AppendString(FStringBuilderBase& Out) const;
     FString ToString() const;
 };
\ No newline at end of file
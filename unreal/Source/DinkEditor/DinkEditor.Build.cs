@@ -44,7 +44,8 @@ public class DinkEditor : ModuleRules
                 "Projects",
                 "Json",
                 "JsonUtilities",
-                "DeveloperSettings"
+                "DeveloperSettings",
+                "DeveloperToolSettings"
             }
             );
 
@@ -0,0 +1,215 @@
+#include "DinkChunkWriter.h"
+#include "DinkEditor.h"
+#include "DinkRuntime.h"
+#include "DinkRuntimeParser.h"
+#include "Async/ParallelFor.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+#include "Serialization/JsonSerializer.h"
+#include "Policies/CondensedJsonPrintPolicy.h"
+#include <atomic>
+
+static bool SaveJsonObject(const TSharedRef<FJsonObject>& JsonObject, const FString& FilePath)
+{
+    FString JsonRaw;
+    TSharedRef<TJsonWriter<TCHAR, TCondensedJsonPrintPolicy<TCHAR>>> Writer = TJsonWriterFactory<TCHAR, TCondensedJsonPrintPolicy<TCHAR>>::Create(&JsonRaw);
+    if (!FJsonSerializer::Serialize(JsonObject, Writer) || !FFileHelper::SaveStringToFile(JsonRaw, *FilePath, FFileHelper::EEncodingOptions::ForceUTF8WithoutBOM))
+    {
+        UE_LOG(LogDinkEditor, Error, TEXT("Couldn't write %s"), *FilePath);
+        return false;
+    }
+    return true;
+}
+
+// Writes a beat back out the same way the compiler does
+static TSharedRef<FJsonObject> BeatToJson(const FDinkBeat& Beat, const FString* ActionText)
+{
+    TSharedRef<FJsonObject> BeatObj = MakeShared<FJsonObject>();
+    if (Beat.Type == EDinkBeatType::Action)
+    {
+        BeatObj->SetStringField(TEXT("Type"), TEXT("Action"));
+        BeatObj->SetStringField(TEXT("SceneID"), Beat.SceneID.ToString());
+        if (ActionText)
+            BeatObj->SetStringField(TEXT("Text"), *ActionText);
+    }
+    else
+    {
+        BeatObj->SetStringField(TEXT("Type"), TEXT("Line"));
+        BeatObj->SetStringField(TEXT("SceneID"), Beat.SceneID.ToString());
+        BeatObj->SetStringField(TEXT("CharacterID"), Beat.CharacterID.ToString());
+        BeatObj->SetStringField(TEXT("Qualifier"), Beat.Qualifier.IsNone() ? FString() : Beat.Qualifier.ToString());
+    }
+    return BeatObj;
+}
+
+bool UDinkChunkWriter::WriteChunks(const FString& RuntimeFile, const TArray<FString>& StringsFiles, const FString& DestFolder)
+{
+    // main-dink.json -> main
+    FString RootName = FPaths::GetBaseFilename(RuntimeFile);
+    RootName.RemoveFromEnd(TEXT("-dink"));
+
+    FString JsonRaw;
+    TMap<FName, FDinkBeat> Beats;
+    TMap<FName, FString> ActionText;
+    if (!FFileHelper::LoadFileToString(JsonRaw, *RuntimeFile) || !UDinkRuntimeParser::ParseJSON(JsonRaw, Beats, ActionText))
+    {
+        UE_LOG(LogDinkEditor, Error, TEXT("Couldn't load %s"), *RuntimeFile);
+        return false;
+    }
+
+    TArray<TMap<FName, FString>> LocaleStrings;
+    LocaleStrings.SetNum(StringsFiles.Num());
+    TMap<FString, const TMap<FName, FString>*> Strings;
+
+    const FString StringsPrefix = RootName + TEXT("-strings-");
+    for (int32 i = 0; i < StringsFiles.Num(); ++i)
+    {
+        // main-strings-en-GB.json -> en-GB
+        FString Locale = FPaths::GetBaseFilename(StringsFiles[i]);
+        if (!Locale.RemoveFromStart(StringsPrefix))
+        {
+            UE_LOG(LogDinkEditor, Error, TEXT("Strings file %s doesn't match runtime file %s."), *StringsFiles[i], *RuntimeFile);
+            return false;
+        }
+
+        if (!FFileHelper::LoadFileToString(JsonRaw, *StringsFiles[i]) || !UDinkRuntimeParser::ParseStringsJSON(JsonRaw, LocaleStrings[i]))
+        {
+            UE_LOG(LogDinkEditor, Error, TEXT("Couldn't load %s"), *StringsFiles[i]);
+            return false;
+        }
+        Strings.Add(Locale, &LocaleStrings[i]);
+    }
+
+    return WriteChunks(RootName, Beats, ActionText, Strings, DestFolder);
+}
+
+bool UDinkChunkWriter::WriteChunks(const FString& RootName, const TMap<FName, FDinkBeat>& Beats, const TMap<FName, FString>& ActionText,
+    const TMap<FString, const TMap<FName, FString>*>& Strings, const FString& DestFolder)
+{
+    // Group the beats by scene
+    TMap<FName, TArray<FName>> SceneLines;
+    TSharedRef<FJsonObject> ManifestLines = MakeShared<FJsonObject>();
+    for (const auto& Pair : Beats)
+    {
+        if (Pair.Value.SceneID.IsNone())
+        {
+            UE_LOG(LogDinkEditor, Error, TEXT("Beat %s in %s has no SceneID - recompile with a newer DinkCompiler."), *Pair.Key.ToString(), *RootName);
+            return false;
+        }
+
+        SceneLines.FindOrAdd(Pair.Value.SceneID).Add(Pair.Key);
+        ManifestLines->SetStringField(Pair.Key.ToString(), Pair.Value.SceneID.ToString());
+    }
+
+    TArray<FName> SceneIDs;
+    SceneLines.GenerateKeyArray(SceneIDs);
+
+    TArray<FString> Locales;
+    Strings.GenerateKeyArray(Locales);
+
+    // Each scene's beats and strings go in their own chunk files. Strings
+    // go in with the scene of the beat they belong to.
+    TArray<TSharedPtr<FJsonObject>> ManifestSceneObjs;
+    ManifestSceneObjs.SetNum(SceneIDs.Num());
+    std::atomic<int32> Failures = 0;
+    ParallelFor(SceneIDs.Num(), [&](int32 SceneIndex)
+    {
+        const FName SceneID = SceneIDs[SceneIndex];
+        const TArray<FName>& LineIDs = SceneLines[SceneID];
+
+        TSharedRef<FJsonObject> BeatsObj = MakeShared<FJsonObject>();
+        for (const FName& LineID : LineIDs)
+            BeatsObj->SetObjectField(LineID.ToString(), BeatToJson(Beats[LineID], ActionText.Find(LineID)));
+
+        FString DinkFile = FString::Printf(TEXT("%s-dink.%s.json"), *RootName, *SceneID.ToString());
+        if (!SaveJsonObject(BeatsObj, FPaths::Combine(DestFolder, DinkFile)))
+        {
+            Failures++;
+            return;
+        }
+
+        TSharedRef<FJsonObject> SceneObj = MakeShared<FJsonObject>();
+        TSharedRef<FJsonObject> SceneStringsObj = MakeShared<FJsonObject>();
+        SceneObj->SetStringField(TEXT("Dink"), DinkFile);
+
+        for (const FString& Locale : Locales)
+        {
+            const TMap<FName, FString>& LocaleStrings = *Strings[Locale];
+
+            TSharedRef<FJsonObject> StringsObj = MakeShared<FJsonObject>();
+            for (const FName& LineID : LineIDs)
+            {
+                if (const FString* Text = LocaleStrings.Find(LineID))
+                    StringsObj->SetStringField(LineID.ToString(), *Text);
+            }
+            if (StringsObj->Values.Num() == 0)
+                continue;
+
+            FString ChunkFile = FString::Printf(TEXT("%s-strings-%s.%s.json"), *RootName, *Locale, *SceneID.ToString());
+            if (!SaveJsonObject(StringsObj, FPaths::Combine(DestFolder, ChunkFile)))
+            {
+                Failures++;
+                return;
+            }
+            SceneStringsObj->SetStringField(Locale, ChunkFile);
+        }
+
+        SceneObj->SetObjectField(TEXT("Strings"), SceneStringsObj);
+        ManifestSceneObjs[SceneIndex] = SceneObj;
+    });
+
+    // Strings that don't belong to any beat (e.g. non-Dink Ink lines) go in
+    // the common strings, which stay resident.
+    TArray<FString> CommonFiles;
+    CommonFiles.SetNum(Locales.Num());
+    ParallelFor(Locales.Num(), [&](int32 LocaleIndex)
+    {
+        const FString& Locale = Locales[LocaleIndex];
+
+        TSharedRef<FJsonObject> CommonStrings = MakeShared<FJsonObject>();
+        for (const auto& Pair : *Strings[Locale])
+        {
+            if (!Beats.Contains(Pair.Key))
+                CommonStrings->SetStringField(Pair.Key.ToString(), Pair.Value);
+        }
+
+        CommonFiles[LocaleIndex] = FString::Printf(TEXT("%s-common-strings-%s.json"), *RootName, *Locale);
+        if (!SaveJsonObject(CommonStrings, FPaths::Combine(DestFolder, CommonFiles[LocaleIndex])))
+            Failures++;
+    });
+
+    if (Failures > 0)
+        return false;
+
+    // Build the line index now so the runtime can load it as-is
+    FDinkLineIndex LineIndex;
+    LineIndex.Build(Beats);
+    TSharedRef<FJsonObject> ManifestIndex = MakeShared<FJsonObject>();
+    LineIndex.WriteJson(*ManifestIndex);
+
+    TSharedRef<FJsonObject> ManifestScenes = MakeShared<FJsonObject>();
+    for (int32 i = 0; i < SceneIDs.Num(); ++i)
+        ManifestScenes->SetObjectField(SceneIDs[i].ToString(), ManifestSceneObjs[i]);
+
+    TSharedRef<FJsonObject> ManifestCommonStrings = MakeShared<FJsonObject>();
+    TArray<TSharedPtr<FJsonValue>> ManifestLocales;
+    for (int32 i = 0; i < Locales.Num(); ++i)
+    {
+        ManifestCommonStrings->SetStringField(Locales[i], CommonFiles[i]);
+        ManifestLocales.Add(MakeShared<FJsonValueString>(Locales[i]));
+    }
+
+    TSharedRef<FJsonObject> Manifest = MakeShared<FJsonObject>();
+    Manifest->SetArrayField(TEXT("Locales"), ManifestLocales);
+    Manifest->SetObjectField(TEXT("CommonStrings"), ManifestCommonStrings);
+    Manifest->SetObjectField(TEXT("Scenes"), ManifestScenes);
+    Manifest->SetObjectField(TEXT("Lines"), ManifestLines);
+    Manifest->SetObjectField(TEXT("Index"), ManifestIndex);
+
+    FString ManifestFile = FPaths::Combine(DestFolder, RootName + TEXT("-dink-manifest.json"));
+    if (!SaveJsonObject(Manifest, ManifestFile))
+        return false;
+
+    UE_LOG(LogDinkEditor, Log, TEXT("Wrote %d Dink scene chunks and manifest %s"), SceneIDs.Num(), *ManifestFile);
+    return true;
+}
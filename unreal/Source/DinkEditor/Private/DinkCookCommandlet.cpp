@@ -0,0 +1,355 @@
+#include "DinkCookCommandlet.h"
+#include "DinkEditor.h"
+#include "DinkEditorSettings.h"
+#include "DinkChunkWriter.h"
+#include "DinkRuntime.h"
+#include "DinkRuntimeParser.h"
+#include "DinkStructure.h"
+#include "DinkStructureParser.h"
+#include "Algo/BinarySearch.h"
+#include "AssetRegistry/AssetRegistryModule.h"
+#include "Async/ParallelFor.h"
+#include "HAL/FileManager.h"
+#include "Misc/App.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Parse.h"
+#include "Misc/Paths.h"
+#include "Settings/ProjectPackagingSettings.h"
+#include "Sound/SoundBase.h"
+#include <atomic>
+
+// Everything compiled from one root Ink file e.g. main-dink.json,
+// main-strings-en-GB.json and main-dink-structure.json
+struct FDinkCookJob
+{
+    FString RootName;
+    FString RuntimeFile;
+    TArray<FString> StringsFiles;
+    FString StructureFile;
+
+    TMap<FName, FDinkBeat> Beats;
+    TMap<FName, FString> ActionText;
+    TArray<FString> Locales;
+    TArray<TMap<FName, FString>> Strings;
+    TArray<FDinkStructureScene> Scenes;
+};
+
+// Validation runs on many threads at once, so counts are shared atomics
+struct FDinkCookCounts
+{
+    std::atomic<int32> Errors = 0;
+    std::atomic<int32> Warnings = 0;
+};
+
+static bool LoadFile(const FString& FilePath, FString& OutJsonRaw)
+{
+    if (FFileHelper::LoadFileToString(OutJsonRaw, *FilePath))
+        return true;
+    UE_LOG(LogDinkEditor, Error, TEXT("Couldn't read %s"), *FilePath);
+    return false;
+}
+
+static void FindJobs(const FString& SourceFolder, TArray<FDinkCookJob>& OutJobs)
+{
+    TArray<FString> RuntimeFiles;
+    IFileManager::Get().FindFiles(RuntimeFiles, *FPaths::Combine(SourceFolder, TEXT("*-dink.json")), true, false);
+
+    for (const FString& RuntimeFile : RuntimeFiles)
+    {
+        FDinkCookJob& Job = OutJobs.AddDefaulted_GetRef();
+        Job.RootName = FPaths::GetBaseFilename(RuntimeFile);
+        Job.RootName.RemoveFromEnd(TEXT("-dink"));
+        Job.RuntimeFile = FPaths::Combine(SourceFolder, RuntimeFile);
+
+        TArray<FString> StringsFiles;
+        IFileManager::Get().FindFiles(StringsFiles, *FPaths::Combine(SourceFolder, Job.RootName + TEXT("-strings-*.json")), true, false);
+        StringsFiles.Sort();
+        for (const FString& StringsFile : StringsFiles)
+        {
+            // Skip chunks from an earlier cook into the same folder e.g. main-strings-en-GB.Scene.json
+            FString Locale = FPaths::GetBaseFilename(StringsFile);
+            Locale.RemoveFromStart(Job.RootName + TEXT("-strings-"));
+            if (Locale.Contains(TEXT(".")))
+                continue;
+
+            Job.StringsFiles.Add(FPaths::Combine(SourceFolder, StringsFile));
+            Job.Locales.Add(Locale);
+        }
+        Job.Strings.SetNum(Job.StringsFiles.Num());
+
+        FString StructureFile = FPaths::Combine(SourceFolder, Job.RootName + TEXT("-dink-structure.json"));
+        if (FPaths::FileExists(StructureFile))
+            Job.StructureFile = StructureFile;
+    }
+}
+
+// Reads every file from every job, one file per task.
+static bool ParseJobs(TArray<FDinkCookJob>& Jobs)
+{
+    struct FParseTask
+    {
+        FDinkCookJob* Job;
+        int32 StringsIndex; // INDEX_NONE for the runtime file, Strings.Num() for the structure
+    };
+
+    TArray<FParseTask> Tasks;
+    for (FDinkCookJob& Job : Jobs)
+    {
+        Tasks.Add({ &Job, INDEX_NONE });
+        for (int32 i = 0; i < Job.StringsFiles.Num(); ++i)
+            Tasks.Add({ &Job, i });
+        if (!Job.StructureFile.IsEmpty())
+            Tasks.Add({ &Job, Job.StringsFiles.Num() });
+    }
+
+    std::atomic<int32> Failures = 0;
+    ParallelFor(Tasks.Num(), [&](int32 TaskIndex)
+    {
+        const FParseTask& Task = Tasks[TaskIndex];
+        FDinkCookJob& Job = *Task.Job;
+
+        FString JsonRaw;
+        bool bParsed = false;
+        if (Task.StringsIndex == INDEX_NONE)
+            bParsed = LoadFile(Job.RuntimeFile, JsonRaw) && UDinkRuntimeParser::ParseJSON(JsonRaw, Job.Beats, Job.ActionText);
+        else if (Task.StringsIndex < Job.StringsFiles.Num())
+            bParsed = LoadFile(Job.StringsFiles[Task.StringsIndex], JsonRaw) && UDinkRuntimeParser::ParseStringsJSON(JsonRaw, Job.Strings[Task.StringsIndex]);
+        else
+            bParsed = LoadFile(Job.StructureFile, JsonRaw) && UDinkStructureParser::ParseJSON(JsonRaw, Job.Scenes);
+
+        if (!bParsed)
+            Failures++;
+    });
+
+    return Failures == 0;
+}
+
+// Checks every beat in parallel, so a single large root file still uses every core
+static void ValidateJob(const FDinkCookJob& Job, const TArray<FString>& VoiceAssetNames, bool bCheckVoice, FDinkCookCounts& Counts)
+{
+    // Flatten the structure first, so its beats can be checked in parallel too
+    TArray<TPair<FName, const FDinkStructureBeat*>> StructureBeats;
+    TSet<FName> StructureLineIDs;
+    for (const FDinkStructureScene& Scene : Job.Scenes)
+    {
+        for (const FDinkStructureBlock& Block : Scene.Blocks)
+        {
+            for (const FDinkStructureSnippet& Snippet : Block.Snippets)
+            {
+                for (const FDinkStructureBeat& Beat : Snippet.Beats)
+                {
+                    StructureBeats.Emplace(Scene.SceneID, &Beat);
+                    StructureLineIDs.Add(Beat.LineID);
+                }
+            }
+        }
+    }
+
+    // The structure and runtime files should describe the same beats. Actions
+    // can legitimately be missing from the runtime file if they're localised.
+    ParallelFor(StructureBeats.Num(), [&](int32 Index)
+    {
+        const FName SceneID = StructureBeats[Index].Key;
+        const FDinkStructureBeat& Beat = *StructureBeats[Index].Value;
+
+        const FDinkBeat* RuntimeBeat = Job.Beats.Find(Beat.LineID);
+        if (!RuntimeBeat)
+        {
+            if (Beat.Type == EDinkBeatType::Line)
+            {
+                UE_LOG(LogDinkEditor, Error, TEXT("%s: line %s is in the structure file but not the runtime file."), *Job.RootName, *Beat.LineID.ToString());
+                Counts.Errors++;
+            }
+            return;
+        }
+
+        if (RuntimeBeat->Type != Beat.Type || RuntimeBeat->CharacterID != Beat.CharacterID || RuntimeBeat->SceneID != SceneID)
+        {
+            UE_LOG(LogDinkEditor, Error, TEXT("%s: beat %s differs between the structure and runtime files - are they from the same compile?"), *Job.RootName, *Beat.LineID.ToString());
+            Counts.Errors++;
+        }
+    });
+
+    TArray<FName> LineIDs;
+    Job.Beats.GenerateKeyArray(LineIDs);
+
+    ParallelFor(LineIDs.Num(), [&](int32 Index)
+    {
+        const FName LineID = LineIDs[Index];
+        const FDinkBeat& Beat = Job.Beats[LineID];
+
+        // Every beat needs a scene so it can be chunked
+        if (Beat.SceneID.IsNone())
+        {
+            UE_LOG(LogDinkEditor, Error, TEXT("%s: beat %s has no SceneID - recompile with a newer DinkCompiler."), *Job.RootName, *LineID.ToString());
+            Counts.Errors++;
+        }
+
+        if (Job.Scenes.Num() > 0 && !StructureLineIDs.Contains(LineID))
+        {
+            UE_LOG(LogDinkEditor, Error, TEXT("%s: beat %s is in the runtime file but not the structure file."), *Job.RootName, *LineID.ToString());
+            Counts.Errors++;
+        }
+
+        if (Beat.Type != EDinkBeatType::Line)
+            return;
+
+        // Every spoken line needs its text in every locale
+        for (int32 i = 0; i < Job.StringsFiles.Num(); ++i)
+        {
+            if (!Job.Strings[i].Contains(LineID))
+            {
+                UE_LOG(LogDinkEditor, Error, TEXT("%s: line %s missing from %s"), *Job.RootName, *LineID.ToString(), *FPaths::GetCleanFilename(Job.StringsFiles[i]));
+                Counts.Errors++;
+            }
+        }
+
+        // Voice assets are named after their LineID, perhaps with a suffix, the
+        // same as the compiler's audio status check. Names are sorted and
+        // lowercased, so the first name not less than the LineID is the only candidate.
+        if (bCheckVoice)
+        {
+            const FString LineIDLower = LineID.ToString().ToLower();
+            const int32 Candidate = Algo::LowerBound(VoiceAssetNames, LineIDLower);
+            if (!VoiceAssetNames.IsValidIndex(Candidate) || !VoiceAssetNames[Candidate].StartsWith(LineIDLower, ESearchCase::CaseSensitive))
+            {
+                UE_LOG(LogDinkEditor, Warning, TEXT("%s: no voice asset for line %s"), *Job.RootName, *LineID.ToString());
+                Counts.Warnings++;
+            }
+        }
+    });
+}
+
+static void GatherVoiceAssetNames(const FString& VoiceAssetPath, TArray<FString>& OutNames)
+{
+    IAssetRegistry& AssetRegistry = FModuleManager::LoadModuleChecked<FAssetRegistryModule>("AssetRegistry").Get();
+    AssetRegistry.SearchAllAssets(true);
+
+    FARFilter Filter;
+    Filter.PackagePaths.Add(FName(*VoiceAssetPath));
+    Filter.bRecursivePaths = true;
+    Filter.ClassPaths.Add(USoundBase::StaticClass()->GetClassPathName());
+    Filter.bRecursiveClasses = true;
+
+    TArray<FAssetData> Assets;
+    AssetRegistry.GetAssets(Filter, Assets);
+
+    OutNames.Reserve(Assets.Num());
+    for (const FAssetData& Asset : Assets)
+        OutNames.Add(Asset.AssetName.ToString().ToLower());
+    OutNames.Sort();
+}
+
+UDinkCookCommandlet::UDinkCookCommandlet()
+{
+    IsClient = false;
+    IsEditor = true;
+    IsServer = false;
+    LogToConsole = true;
+}
+
+int32 UDinkCookCommandlet::Main(const FString& Params)
+{
+    return RunCook(Params) ? 0 : 1;
+}
+
+bool UDinkCookCommandlet::IsStaged(const FString& Folder)
+{
+    // Staged directories are relative to the Content folder
+    FString RelativeFolder = FPaths::ConvertRelativePathToFull(Folder);
+    if (!FPaths::MakePathRelativeTo(RelativeFolder, *FPaths::ConvertRelativePathToFull(FPaths::ProjectContentDir())) || RelativeFolder.StartsWith(TEXT("..")))
+        return false;
+    FPaths::NormalizeDirectoryName(RelativeFolder);
+
+    const UProjectPackagingSettings* PackagingSettings = GetDefault<UProjectPackagingSettings>();
+    for (const FDirectoryPath& Directory : PackagingSettings->DirectoriesToAlwaysStageAsUFS)
+    {
+        FString StagedFolder = Directory.Path;
+        FPaths::NormalizeDirectoryName(StagedFolder);
+        if (FPaths::IsSamePath(StagedFolder, RelativeFolder) || RelativeFolder.StartsWith(StagedFolder + TEXT("/")))
+            return true;
+    }
+    return false;
+}
+
+bool UDinkCookCommandlet::RunCook(const FString& Params)
+{
+    const double StartTime = FPlatformTime::Seconds();
+    const UDinkEditorSettings* Settings = GetDefault<UDinkEditorSettings>();
+
+    FString SourceFolder = FPaths::Combine(FPaths::ProjectDir(), Settings->OutputFolder);
+    FString DestFolder = FPaths::Combine(FPaths::ProjectContentDir(), Settings->ChunkFolder);
+    FString VoiceAssetPath = Settings->VoiceAssetPath;
+    FParse::Value(*Params, TEXT("Source="), SourceFolder);
+    FParse::Value(*Params, TEXT("Dest="), DestFolder);
+    FParse::Value(*Params, TEXT("VoicePath="), VoiceAssetPath);
+
+    SourceFolder = FPaths::ConvertRelativePathToFull(SourceFolder);
+    DestFolder = FPaths::ConvertRelativePathToFull(DestFolder);
+
+    // The chunks aren't assets, so a package built without them staged would
+    // silently have no dialogue
+    if (!IsStaged(DestFolder))
+    {
+        UE_LOG(LogDinkEditor, Error, TEXT("%s isn't in the packaging settings' Additional Non-Asset Directories to Package (DirectoriesToAlwaysStageAsUFS), so the Dink chunks wouldn't be packaged. Add it, e.g. with Add Chunk Folder To Staging in the Dink Editor Settings."), *DestFolder);
+        return false;
+    }
+
+    TArray<FDinkCookJob> Jobs;
+    FindJobs(SourceFolder, Jobs);
+    if (Jobs.Num() == 0)
+    {
+        UE_LOG(LogDinkEditor, Error, TEXT("No compiled Dink runtime files found in %s"), *SourceFolder);
+        return false;
+    }
+
+    if (!ParseJobs(Jobs))
+        return false;
+
+    TArray<FString> VoiceAssetNames;
+    const bool bCheckVoice = !VoiceAssetPath.IsEmpty();
+    if (bCheckVoice)
+        GatherVoiceAssetNames(VoiceAssetPath, VoiceAssetNames);
+
+    FDinkCookCounts Counts;
+    int32 Lines = 0;
+    for (const FDinkCookJob& Job : Jobs)
+    {
+        ValidateJob(Job, VoiceAssetNames, bCheckVoice, Counts);
+        Lines += Job.Beats.Num();
+    }
+
+    if (Counts.Errors > 0)
+    {
+        UE_LOG(LogDinkEditor, Error, TEXT("Dink cook failed validation with %d errors and %d warnings."), Counts.Errors.load(), Counts.Warnings.load());
+        return false;
+    }
+
+    IFileManager::Get().MakeDirectory(*DestFolder, true);
+
+    // UDink streams from a single manifest, so every root Ink file's output
+    // is merged into one, named after the project. Scenes that several roots
+    // include are the same beats, so they merge into a single chunk. This
+    // reuses what was parsed for validation.
+    TMap<FName, FDinkBeat> Beats;
+    TMap<FName, FString> ActionText;
+    TMap<FString, TMap<FName, FString>> LocaleStrings;
+    for (const FDinkCookJob& Job : Jobs)
+    {
+        Beats.Append(Job.Beats);
+        ActionText.Append(Job.ActionText);
+        for (int32 i = 0; i < Job.Locales.Num(); ++i)
+            LocaleStrings.FindOrAdd(Job.Locales[i]).Append(Job.Strings[i]);
+    }
+
+    TMap<FString, const TMap<FName, FString>*> Strings;
+    for (const auto& Pair : LocaleStrings)
+        Strings.Add(Pair.Key, &Pair.Value);
+
+    if (!UDinkChunkWriter::WriteChunks(FApp::GetProjectName(), Beats, ActionText, Strings, DestFolder))
+        return false;
+
+    UE_LOG(LogDinkEditor, Display, TEXT("Dink cook processed %d beats from %d files in %.2fs with %d warnings."),
+        Lines, Jobs.Num(), FPlatformTime::Seconds() - StartTime, Counts.Warnings.load());
+    return true;
+}
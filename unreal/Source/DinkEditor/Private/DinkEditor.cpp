@@ -1,6 +1,9 @@
 #include "DinkEditor.h"
+#include "DinkCookCommandlet.h"
+#include "DinkEditorSettings.h"
 #include "Modules/ModuleManager.h"
 #include "Logging/LogMacros.h"
+#include "UObject/ICookInfo.h"
 
 #define LOCTEXT_NAMESPACE "FDinkEditorModule"
 
@@ -42,10 +45,24 @@ void UDinkEditor::Register()
 void FDinkEditorModule::StartupModule()
 {
     UE_LOG(LogDinkEditor, Log, TEXT("DinkEditor module has started."));
+
+    CookStartedHandle = UE::Cook::FDelegates::CookByTheBookStarted.AddRaw(this, &FDinkEditorModule::OnCookStarted);
 }
 
 void FDinkEditorModule::ShutdownModule()
 {
+    UE::Cook::FDelegates::CookByTheBookStarted.Remove(CookStartedHandle);
+}
+
+void FDinkEditorModule::OnCookStarted(UE::Cook::ICookInfo& CookInfo)
+{
+    const UDinkEditorSettings* Settings = GetDefault<UDinkEditorSettings>();
+    if (!Settings->bRunDuringCook || Settings->OutputFolder.IsEmpty())
+        return;
+
+    // Chunks are written before any packages are cooked, so they're ready to stage
+    if (!UDinkCookCommandlet::RunCook(FString()))
+        UE_LOG(LogDinkEditor, Error, TEXT("Dink cook step failed, see above. The packaged Dink chunks will be out of date."));
 }
 
 IMPLEMENT_MODULE(FDinkEditorModule, DinkEditor)
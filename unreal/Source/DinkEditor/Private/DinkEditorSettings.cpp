@@ -0,0 +1,25 @@
+#include "DinkEditorSettings.h"
+#include "DinkEditor.h"
+#include "Settings/ProjectPackagingSettings.h"
+
+void UDinkEditorSettings::AddChunkFolderToStaging()
+{
+    if (ChunkFolder.IsEmpty())
+        return;
+
+    UProjectPackagingSettings* PackagingSettings = GetMutableDefault<UProjectPackagingSettings>();
+    for (const FDirectoryPath& Directory : PackagingSettings->DirectoriesToAlwaysStageAsUFS)
+    {
+        if (FPaths::IsSamePath(Directory.Path, ChunkFolder))
+            return;
+    }
+
+    FDirectoryPath ChunkDirectory;
+    ChunkDirectory.Path = ChunkFolder;
+    PackagingSettings->DirectoriesToAlwaysStageAsUFS.Add(ChunkDirectory);
+
+    if (PackagingSettings->TryUpdateDefaultConfigFile())
+        UE_LOG(LogDinkEditor, Log, TEXT("Added Content/%s to the directories to package, for the Dink chunks."), *ChunkFolder);
+    else
+        UE_LOG(LogDinkEditor, Error, TEXT("Couldn't save DefaultGame.ini - is it checked out?"));
+}
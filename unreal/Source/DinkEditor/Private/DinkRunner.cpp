@@ -4,6 +4,89 @@
 #include "DinkEditor.h"
 #include "HAL/PlatformProcess.h"
 #include "DinkEditorSettings.h"
+#include "Serialization/JsonSerializer.h"
+
+FOnDinkCompilerDiagnostic UDinkRunner::OnDiagnostic;
+FOnDinkCompilerPhase UDinkRunner::OnPhase;
+FOnDinkCompilerOutput UDinkRunner::OnOutput;
+FOnDinkCompilerResult UDinkRunner::OnResult;
+
+static EDinkCompilerSeverity ParseSeverity(const FString& SeverityStr)
+{
+    if (SeverityStr.Equals(TEXT("Error"), ESearchCase::IgnoreCase))
+        return EDinkCompilerSeverity::Error;
+    if (SeverityStr.Equals(TEXT("Warning"), ESearchCase::IgnoreCase))
+        return EDinkCompilerSeverity::Warning;
+    return EDinkCompilerSeverity::Info;
+}
+
+// Decodes one JSON event line from the compiler. Returns false if the line
+// isn't an event, so it can be logged as plain output instead.
+static bool HandleCompilerEvent(const FString& Line)
+{
+    if (!Line.StartsWith(TEXT("{")))
+        return false;
+
+    TSharedRef<TJsonReader<>> Reader = TJsonReaderFactory<>::Create(Line);
+    TSharedPtr<FJsonObject> EventObj;
+    FString Event;
+    if (!FJsonSerializer::Deserialize(Reader, EventObj) || !EventObj.IsValid() || !EventObj->TryGetStringField(TEXT("Event"), Event))
+        return false;
+
+    if (Event == TEXT("Diagnostic"))
+    {
+        FDinkCompilerDiagnostic Diagnostic;
+        Diagnostic.Severity = ParseSeverity(EventObj->GetStringField(TEXT("Severity")));
+        EventObj->TryGetStringField(TEXT("File"), Diagnostic.File);
+        EventObj->TryGetNumberField(TEXT("Line"), Diagnostic.Line);
+        EventObj->TryGetStringField(TEXT("Message"), Diagnostic.Message);
+
+        if (Diagnostic.Severity == EDinkCompilerSeverity::Error)
+            UE_LOG(LogDinkEditor, Error, TEXT("%s(%d): %s"), *Diagnostic.File, Diagnostic.Line, *Diagnostic.Message);
+        else if (Diagnostic.Severity == EDinkCompilerSeverity::Warning)
+            UE_LOG(LogDinkEditor, Warning, TEXT("%s(%d): %s"), *Diagnostic.File, Diagnostic.Line, *Diagnostic.Message);
+
+        UDinkRunner::OnDiagnostic.Broadcast(Diagnostic);
+    }
+    else if (Event == TEXT("Phase"))
+    {
+        const FString Name = EventObj->GetStringField(TEXT("Name"));
+        const double Seconds = EventObj->GetNumberField(TEXT("Seconds"));
+        UE_LOG(LogDinkEditor, Verbose, TEXT("Dink compiler phase %s took %.3fs"), *Name, Seconds);
+        UDinkRunner::OnPhase.Broadcast(Name, Seconds);
+    }
+    else if (Event == TEXT("Output"))
+    {
+        const FString Path = EventObj->GetStringField(TEXT("Path"));
+        UE_LOG(LogDinkEditor, Verbose, TEXT("Dink compiler wrote %s"), *Path);
+        UDinkRunner::OnOutput.Broadcast(Path);
+    }
+    else if (Event == TEXT("Result"))
+    {
+        UDinkRunner::OnResult.Broadcast(EventObj->GetBoolField(TEXT("Success")), EventObj->GetNumberField(TEXT("Seconds")));
+    }
+    return true;
+}
+
+// Splits whatever has arrived on the pipe into complete lines, keeping any
+// trailing partial line until the rest of it turns up.
+static void ProcessCompilerOutput(const FString& LatestOutput, FString& PendingLine)
+{
+    PendingLine += LatestOutput;
+
+    int32 Start = 0;
+    int32 NewLine;
+    while ((NewLine = PendingLine.Find(TEXT("\n"), ESearchCase::CaseSensitive, ESearchDir::FromStart, Start)) != INDEX_NONE)
+    {
+        FString Line = PendingLine.Mid(Start, NewLine - Start);
+        Line.TrimEndInline();
+        Start = NewLine + 1;
+
+        if (!Line.IsEmpty() && !HandleCompilerEvent(Line))
+            UE_LOG(LogDinkEditor, Log, TEXT("%s"), *Line);
+    }
+    PendingLine.RightChopInline(Start);
+}
 
 bool FindExePath(FString& outPath)
 {
@@ -26,7 +109,7 @@ bool RunCompiler(TArray<FString>& args)
     if (!FindExePath(AbsoluteExePath))
         return false;
 
-    FString Params = FString::Join(args, TEXT(" "));
+    FString Params = FString::Join(args, TEXT(" ")) + TEXT(" --events");
 
     UE_LOG(LogDinkEditor, Log, TEXT("Calling DinkCompiler with params:\"%s\""), *Params);
 
@@ -55,23 +138,15 @@ bool RunCompiler(TArray<FString>& args)
 
     if (Handle.IsValid())
     {
-        FString StdOutput;
-        FString LatestOutput;
+        FString PendingLine;
 
         while (FPlatformProcess::IsProcRunning(Handle))
         {
-            LatestOutput = FPlatformProcess::ReadPipe(PipeRead);
-            StdOutput += LatestOutput;
-            if (!LatestOutput.IsEmpty())
-                UE_LOG(LogDinkEditor, Log, TEXT("%s"), *LatestOutput);
-
+            ProcessCompilerOutput(FPlatformProcess::ReadPipe(PipeRead), PendingLine);
             FPlatformProcess::Sleep(0.1f);
         }
 
-        LatestOutput = FPlatformProcess::ReadPipe(PipeRead);
-        StdOutput += LatestOutput;
-        if (!LatestOutput.IsEmpty())
-            UE_LOG(LogDinkEditor, Log, TEXT("%s"), *LatestOutput);
+        ProcessCompilerOutput(FPlatformProcess::ReadPipe(PipeRead) + TEXT("\n"), PendingLine);
 
         int32 ReturnCode = 0;
         FPlatformProcess::GetProcReturnCode(Handle, &ReturnCode);
@@ -82,7 +157,6 @@ bool RunCompiler(TArray<FString>& args)
         if (ReturnCode != 0)
         {
             UE_LOG(LogDinkEditor, Error, TEXT("Dink Compiler failed with code %d"), ReturnCode);
-            UE_LOG(LogDinkEditor, Error, TEXT("Output: %s"), *StdOutput);
             return false;
         }
     }
@@ -1,5 +1,6 @@
 #include "DinkStructureParser.h"
 #include "DinkStructure.h"
+#include "DinkRuntimeParser.h"
 #include "Serialization/JsonSerializer.h"
 #include "Policies/CondensedJsonPrintPolicy.h"
 
@@ -38,7 +39,7 @@ static FDinkStructureBeat ParseBeat(TSharedPtr<FJsonObject> JsonBeat)
     if (Beat.Type == EDinkBeatType::Line)
     {
         Beat.CharacterID = FName(*JsonBeat->GetStringField(TEXT("CharacterID")));
-        Beat.Qualifier = JsonBeat->GetStringField(TEXT("Qualifier"));
+        Beat.Qualifier = UDinkRuntimeParser::ParseNameField(*JsonBeat, TEXT("Qualifier"));
         Beat.Direction = JsonBeat->GetStringField(TEXT("Direction"));
     }
 
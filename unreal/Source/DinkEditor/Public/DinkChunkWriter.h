@@ -0,0 +1,24 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "DinkChunkWriter.generated.h"
+
+struct FDinkBeat;
+
+UCLASS()
+class DINKEDITOR_API UDinkChunkWriter : public UBlueprintFunctionLibrary
+{
+    GENERATED_BODY()
+public:
+    // Splits a compiled runtime file (e.g. main-dink.json) and its strings files
+    // (e.g. main-strings-en-GB.json) into one chunk per scene, plus a manifest
+    // (main-dink-manifest.json) that UDink::LoadChunkManifest streams them in from.
+    UFUNCTION(BlueprintCallable, Category = "Dink")
+    static bool WriteChunks(const FString& RuntimeFile, const TArray<FString>& StringsFiles, const FString& DestFolder);
+
+    // For callers that have already parsed the runtime and strings files.
+    // RootName is the Ink file's name e.g. main, and Strings is keyed by locale.
+    // Scenes are written in parallel.
+    static bool WriteChunks(const FString& RootName, const TMap<FName, FDinkBeat>& Beats, const TMap<FName, FString>& ActionText,
+        const TMap<FString, const TMap<FName, FString>*>& Strings, const FString& DestFolder);
+};
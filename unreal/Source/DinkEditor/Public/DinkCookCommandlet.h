@@ -0,0 +1,36 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Commandlets/Commandlet.h"
+#include "DinkCookCommandlet.generated.h"
+
+/**
+ * Validates compiled Dink output and writes the runtime chunks, manifest and
+ * line index, so packaged builds don't validate or build anything at startup.
+ * Every root Ink file's output goes into one manifest, <Project>-dink-manifest.json.
+ * Runs automatically at the start of every cook (see bRunDuringCook in the Dink
+ * Editor Settings), or by hand:
+ *
+ *   UnrealEditor-Cmd MyGame.uproject -run=DinkCook [-Source=<folder>] [-Dest=<folder>] [-VoicePath=/Game/...]
+ *
+ * Defaults come from the Dink Editor Settings. Returns non-zero if anything failed validation.
+ */
+UCLASS()
+class DINKEDITOR_API UDinkCookCommandlet : public UCommandlet
+{
+    GENERATED_BODY()
+
+public:
+    UDinkCookCommandlet();
+
+    virtual int32 Main(const FString& Params) override;
+
+    // The whole cook step. Params override the settings, as on the command line.
+    // Fails if the destination folder isn't staged for packaging.
+    static bool RunCook(const FString& Params);
+
+    // The chunks aren't assets, so they're only packaged if their folder is
+    // within one of the project's DirectoriesToAlwaysStageAsUFS. The cook
+    // step fails if it isn't.
+    static bool IsStaged(const FString& Folder);
+};
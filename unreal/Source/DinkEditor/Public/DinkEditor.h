@@ -21,6 +21,8 @@ public:
 private:
 };
 
+namespace UE::Cook { class ICookInfo; }
+
 class FDinkEditorModule : public IModuleInterface
 {
 public:
@@ -30,6 +32,9 @@ public:
 	virtual void ShutdownModule() override;
 
 private:
+	void OnCookStarted(UE::Cook::ICookInfo& CookInfo);
+
+	FDelegateHandle CookStartedHandle;
 };
 
 DECLARE_LOG_CATEGORY_EXTERN(LogDinkEditor, Log, All);
\ No newline at end of file
@@ -28,4 +28,30 @@ public:
     // Where is the project file, if there is one?
     UPROPERTY(Config, EditAnywhere, BlueprintReadOnly, Category = "General")
     FString ProjectFilePath;
+
+    // Where the compiled Dink output files are, relative to the project folder.
+    // The DinkCook commandlet validates everything it finds here.
+    UPROPERTY(Config, EditAnywhere, BlueprintReadOnly, Category = "Cook")
+    FString OutputFolder;
+
+    // Where the DinkCook commandlet writes runtime chunks and the manifest,
+    // relative to the project's Content folder. It must be in the packaging
+    // settings' Additional Non-Asset Directories to Package for the chunks to
+    // be packaged, or the cook step fails.
+    UPROPERTY(Config, EditAnywhere, BlueprintReadOnly, Category = "Cook")
+    FString ChunkFolder = TEXT("Dink");
+
+    // Run the DinkCook step at the start of every cook, if OutputFolder is set.
+    UPROPERTY(Config, EditAnywhere, BlueprintReadOnly, Category = "Cook")
+    bool bRunDuringCook = true;
+
+    // Content path holding voice assets named after their LineIDs e.g. /Game/Audio/Dialogue.
+    // If empty, the DinkCook commandlet doesn't check for missing voice assets.
+    UPROPERTY(Config, EditAnywhere, BlueprintReadOnly, Category = "Cook")
+    FString VoiceAssetPath;
+
+    // Adds ChunkFolder to the packaging settings' Additional Non-Asset
+    // Directories to Package, and saves DefaultGame.ini.
+    UFUNCTION(CallInEditor, Category = "Cook")
+    void AddChunkFolderToStaging();
 };
\ No newline at end of file
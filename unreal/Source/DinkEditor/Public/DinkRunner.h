@@ -3,6 +3,41 @@
 #include "CoreMinimal.h"
 #include "DinkRunner.generated.h"
 
+UENUM(BlueprintType)
+enum class EDinkCompilerSeverity : uint8
+{
+    Info    UMETA(DisplayName = "Info"),
+    Warning UMETA(DisplayName = "Warning"),
+    Error   UMETA(DisplayName = "Error")
+};
+
+// A problem reported by the compiler, pointing back at the source Ink
+USTRUCT(BlueprintType)
+struct DINKEDITOR_API FDinkCompilerDiagnostic
+{
+    GENERATED_BODY()
+
+public:
+    UPROPERTY(BlueprintReadOnly, VisibleAnywhere, Category = "Dink")
+    EDinkCompilerSeverity Severity = EDinkCompilerSeverity::Error;
+
+    // Absolute path, empty if the problem isn't tied to a file
+    UPROPERTY(BlueprintReadOnly, VisibleAnywhere, Category = "Dink")
+    FString File;
+
+    // 0 if the problem isn't tied to a line
+    UPROPERTY(BlueprintReadOnly, VisibleAnywhere, Category = "Dink")
+    int32 Line = 0;
+
+    UPROPERTY(BlueprintReadOnly, VisibleAnywhere, Category = "Dink")
+    FString Message;
+};
+
+DECLARE_MULTICAST_DELEGATE_OneParam(FOnDinkCompilerDiagnostic, const FDinkCompilerDiagnostic& /*Diagnostic*/);
+DECLARE_MULTICAST_DELEGATE_TwoParams(FOnDinkCompilerPhase, const FString& /*PhaseName*/, double /*Seconds*/);
+DECLARE_MULTICAST_DELEGATE_OneParam(FOnDinkCompilerOutput, const FString& /*FilePath*/);
+DECLARE_MULTICAST_DELEGATE_TwoParams(FOnDinkCompilerResult, bool /*bSuccess*/, double /*Seconds*/);
+
 UCLASS()
 class DINKEDITOR_API UDinkRunner : public UBlueprintFunctionLibrary
 {
@@ -16,4 +51,11 @@ public:
 
     UFUNCTION(BlueprintCallable, Category = "Dink")
     static bool CompileWithProject(const FString& sourceFile, const FString& destFolder, bool withStructure = false);
-};
\ No newline at end of file
+
+    // Structured events decoded from the compiler's output while it runs.
+    // These fire on the thread that called the compile.
+    static FOnDinkCompilerDiagnostic OnDiagnostic;
+    static FOnDinkCompilerPhase OnPhase;
+    static FOnDinkCompilerOutput OnOutput;
+    static FOnDinkCompilerResult OnResult;
+};